@@ -4,20 +4,41 @@
 #include <Fonts/FreeSans9pt7b.h>
 #include <WiFi.h>
 #include <Wire.h>
-#include <arduinoFFT.h>
+#include <band_analyzer.h>
+#include <esp_idf_version.h>
+#include <fast_db.h>
+#include <fft_q15.h>
+#include <oled_band_view.h>
+#include <octave_bank.h>
+#include <overlap_buffer.h>
+#include <real_fft.h>
+#include <sliding_dft.h>
+#include <spectrum_bench.h>
+#include <spectrum_config.h>
+#include <stage_profiler.h>
 #include <time.h>
+#if ESP_IDF_VERSION_MAJOR >= 5
+#include <esp_adc/adc_continuous.h>
+#else
+#include <driver/adc.h>
+#endif
 
 /* ================= 硬件与定义 ================= */
 #define SCREEN_WIDTH 128 // SSD1306 屏幕宽度
 #define SCREEN_HEIGHT 64 // SSD1306 屏幕高度
 #define HEADER_H 10      // 顶部文字高度
+#define OLED_ADDR 0x3C   // SSD1306 I2C 地址
+#ifndef OLED_PARTIAL
+#define OLED_PARTIAL 1   // 1: 只发送有变化的页/列区间; 0: 每帧整屏发送 1KB
+#endif
 
-Adafruit_SSD1306 display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, -1);
+// 传输前后都保持 400kHz, 局部刷新时命令与数据使用同一速率
+Adafruit_SSD1306 display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, -1, 400000UL, 400000UL);
 
 /* ================= 新增功能配置区 ================= */
 const char *ssid = "MYWIFI";       // WiFi SSID
 const char *password = "12222222"; // WiFi 密码
-bool wifiFeatureEnabled = true;    // WiFi功能总开关
+volatile bool wifiFeatureEnabled = true; // WiFi功能总开关
 
 const int idleThreshold = 36;            // 进入闲置的分贝阈值
 const int wakeupThreshold = 40;          // 唤醒频谱的分贝阈值
@@ -30,6 +51,69 @@ const char *ntpServer = "162.159.200.1"; // NTP服务器
 #define SAMPLING_FREQ 4000 // 采样频率 (Hz)
 #define BAND_NUM 16        // 频段数量
 #define BLOCK_HIGHT 5      // 垂直方块高度
+#ifndef FFT_Q15
+#define FFT_Q15 0          // 1: 使用 Q15 定点 FFT (ESP32-C3 无 FPU 时更快)
+#endif
+#ifndef ANALYSIS_ENGINE
+#define ANALYSIS_ENGINE 0  // 0: 整块 FFT; 1: 滑动 DFT 滤波器组 (每个采样更新, 计算量约为 FFT 的 5 倍)
+                           // 2: 八度滤波器组 (以 OCTAVE_FS 采样, 频段覆盖 62Hz~16kHz)
+#endif
+#define SDFT_HOP 32        // 滑动 DFT 每隔多少个采样输出一帧 (SAMPLES 的约数)
+#define OCTAVE_FS 32000    // 八度滤波器组的采样频率 (Hz, SAMPLING_FREQ 的整数倍), 最高分析到 OCTAVE_FS / 2
+#define OCTAVES 8          // 八度数, 最低频率为 OCTAVE_FS / 2^(OCTAVES + 1); BAND_NUM 须为其整数倍
+#ifndef FFT_OVERLAP
+#define FFT_OVERLAP 0      // 相邻 FFT 窗口的重叠比例 (%): 0 / 50 / 75, 重叠越多帧率越高, FFT 次数也越多
+#endif
+#define FFT_HOP (SAMPLES * (100 - FFT_OVERLAP) / 100) // FFT 每隔多少个新采样输出一帧
+#ifndef PEAK_INTERP
+#define PEAK_INTERP 2      // 顶部频率读数的峰值插值: 0: 取 bin 中心; 1: 抛物线; 2: 对数抛物线 (误差约 0.6Hz)
+#endif
+#ifndef FFT_ZERO_PAD
+#define FFT_ZERO_PAD 1     // FFT 补零倍数 (1/2/4): 峰值频率更准, FFT 计算量随之成倍增加 (仅 ANALYSIS_ENGINE 0)
+#endif
+#define FFT_SIZE (SAMPLES * FFT_ZERO_PAD) // FFT 点数
+
+#if ANALYSIS_ENGINE == 2
+#define AUDIO_RATE OCTAVE_FS // ADC 采样频率
+#else
+#define AUDIO_RATE SAMPLING_FREQ
+#endif
+#define FRAME_SAMPLES (SAMPLES * (AUDIO_RATE / SAMPLING_FREQ)) // SAMPLES / SAMPLING_FREQ 时长内的采样数
+
+#if ANALYSIS_ENGINE == 2
+#define AUDIO_CHUNK (FRAME_SAMPLES / 4) // 每次采集的采样数 (八度滤波器组每 4 块输出一帧)
+#define FRAME_HOP SAMPLES   // 相邻两帧之间的时长 (按 SAMPLING_FREQ 的采样数计)
+#elif ANALYSIS_ENGINE == 1
+#define AUDIO_CHUNK SAMPLES // 每次采集的采样数 (滑动 DFT 在一块内逐 hop 输出)
+#define FRAME_HOP SDFT_HOP  // 相邻两帧之间的新采样数
+#else
+#define AUDIO_CHUNK FFT_HOP
+#define FRAME_HOP FFT_HOP
+#endif
+#ifndef ADC_DMA
+#define ADC_DMA 1          // 1: ADC 连续模式 + DMA 采样; 0: analogRead 轮询
+#endif
+#define ADC_FRAME_RING (4 * FRAME_SAMPLES / AUDIO_CHUNK) // 驱动内部缓存的采样块数 (共 4 帧的时长)
+#if ANALYSIS_ENGINE == 2 && !ADC_DMA
+#error "八度滤波器组的采样率需要 ADC_DMA"
+#endif
+#ifndef SPECTRUM_BENCH
+#define SPECTRUM_BENCH 0   // 1: 启动时打印热点路径微基准 (CPU 周期/帧)
+#endif
+#ifndef STAGE_PROFILE
+#define STAGE_PROFILE 0    // 1: 统计各阶段耗时, 随每秒统计打印 min/avg/p99/max (us); 0: 完全不参与编译
+#endif
+
+// 任务划分: 采集 -> 分析 -> 显示 之间用队列传递帧, WiFi/NTP 在独立任务中阻塞
+#if CONFIG_FREERTOS_UNICORE
+#define AUDIO_CORE 0       // 单核 (ESP32-C3) 所有任务共用一个核
+#define UI_CORE 0
+#else
+#define AUDIO_CORE 1       // 采集与 FFT
+#define UI_CORE 0          // 显示与 WiFi/NTP (与 WiFi 协议栈同核)
+#endif
+#define AUDIO_QUEUE_LEN (2 * FRAME_SAMPLES / AUDIO_CHUNK) // 采样块队列深度 (共 2 帧的时长)
+#define FRAME_QUEUE_LEN 4  // 频谱帧队列深度
 
 #define noiseFloor 60  // 噪声抑制 越大抑制程度越高
 #define dbMult 6.0     // 放大倍数 越大越灵敏
@@ -38,35 +122,152 @@ const char *ntpServer = "162.159.200.1"; // NTP服务器
 #define smoothDown 0.3 // 下降平滑系数 0~1 越大下降响应越快
 
 /* ================= 全局变量 ================= */
-float vReal[SAMPLES];      // FFT 输入数组
-float vImag[SAMPLES];      // FFT 输出数组
-float bandDb[BAND_NUM];    // 当前显示的频谱数据
-float oldBandDb[BAND_NUM]; // 上次显示的频谱数据
-float peakDb[BAND_NUM];    // 频谱顶点数据
-ArduinoFFT<float> FFT(vReal, vImag, SAMPLES, SAMPLING_FREQ);
+float vReal[FFT_SIZE];      // FFT 输入数组
+#if FFT_Q15
+int16_t qReal[FFT_SIZE];     // 定点 FFT 输入/打包频谱
+uint32_t qMag[FFT_SIZE / 2]; // 定点 FFT 幅值输出
+FftQ15<FFT_SIZE, SAMPLES> qFFT; // 定点 FFT 对象 (前 SAMPLES 点加窗, 其余补零)
+#else
+RealFft<float, FFT_SIZE, SAMPLES> FFT; // 实数 FFT 对象
+#endif
 
-int bin_indices[17] = { // 频段对应的 FFT bin 索引
-    2, 3, 4, 5, 7, 9, 11, 13, 16, 19, 23, 28, 34, 41, 49, 58, 64};
+// 频段边界表与 bin 频率宽度由编译期生成, 修改上面的宏即可
+typedef SpectrumConfig<SAMPLES, SAMPLING_FREQ, BAND_NUM, 2, FFT_ZERO_PAD> Spectrum;
+// 频段平滑与峰值下落 (按 FRAME_HOP 换算, 帧率变化时按实际时间计的速度不变)
+BandAnalyzer<float, Spectrum> bands({noiseFloor, dbMult, peakFall, smoothUp, smoothDown}, 500, FRAME_HOP,
+                                    (PeakInterp)PEAK_INTERP);
+OverlapBuffer<int16_t, SAMPLES> sampleWindow; // 最近 SAMPLES 个采样, 重叠分帧时每次只更新 FFT_HOP 个
+int windowFill = 0;                           // sampleWindow 中连续采样的个数, 未满 SAMPLES 时不输出频谱帧
 
-// 统计与时间
-float maxDb = 0;   // 过去一段时间最大分贝值
-float maxFreq = 0; // 过去一段时间最大分贝值对应频率值
-uint16_t peakTimeInterval = 500; // 峰值更新周期 (ms)
+// 采集任务 -> 分析任务: 一块原始采样 (已去除直流偏置)
+struct AudioFrame {
+  int16_t samples[AUDIO_CHUNK];
+  bool gap; // 与上一块之间丢失了采样 (驱动缓存溢出或 audioQueue 已满), 跨块的分析状态需要重置
+};
 
-unsigned long lastPeakUpdate = 0;
-float delayMs = 1000000 / SAMPLING_FREQ;
+// 分析任务 -> 显示任务: 一帧显示所需的全部数据
+typedef SpectrumFrame<float, BAND_NUM> BandFrame;
+
+QueueHandle_t audioQueue = NULL;    // AudioFrame 队列
+QueueHandle_t frameQueue = NULL;    // BandFrame 队列
+QueueHandle_t messageQueue = NULL;  // 网络任务请求显示的提示文字
+TaskHandle_t networkHandle = NULL;  // 网络任务 (显示任务通知其开始同步时间)
+
+// analogRead 轮询时的采样间隔 (us)
+float delayMs = 1000000 / AUDIO_RATE;
 
 enum SystemMode { MODE_SPECTRUM, MODE_IDLE_TIME };
 SystemMode currentMode = MODE_SPECTRUM;
 
+bool bandScreenValid = false;          // 屏幕上是否为频谱画面 (被其它界面清屏后需完整重绘)
 unsigned long lowVolumeStartTime = 0; // 记录持续低音量的开始时间
-bool isTimeSynced = false;            // 时间是否已同步过
-bool isWifiConnecting = false;        // WiFi 连接中标志
+volatile bool isTimeSynced = false;     // 时间是否已同步过
+volatile bool isWifiConnecting = false; // WiFi 连接中标志
+
+/* ================= 分阶段耗时 ================= */
+
+// 滤波器组模式下 fft 为逐采样更新/抽取, magnitude 为读出各频段幅值
+enum ProfStage { PROF_CAPTURE, PROF_WINDOW, PROF_FFT, PROF_MAGNITUDE, PROF_BANDS, PROF_RENDER, PROF_FLUSH, PROF_COUNT };
+
+#if STAGE_PROFILE
+const char *profNames[PROF_COUNT] = {"capture", "window", "fft", "magnitude", "bands", "render", "flush"};
+StageProfiler<PROF_COUNT> profiler; // 单位: CPU 周期
+
+// PROF_START 开始计时, PROF_LAP 记录从上次计时点到现在的耗时并重新开始
+#define PROF_START(t) uint32_t t = ESP.getCycleCount()
+#define PROF_LAP(stage, t)                      \
+  do {                                          \
+    uint32_t now_ = ESP.getCycleCount();        \
+    profiler.record(stage, now_ - (t));         \
+    t = now_;                                   \
+  } while (0)
+
+// 打印各阶段本周期的统计并开始新周期
+void printProfile() {
+  float mhz = ESP.getCpuFreqMHz();
+  for (int i = 0; i < PROF_COUNT; i++) {
+    StageSummary s = profiler.summary(i);
+    Serial.printf("  %-9s n %4u  min %7.1f  avg %7.1f  p99 %7.1f  max %7.1f us\n", profNames[i], s.count,
+                  s.min / mhz, s.avg / mhz, s.p99 / mhz, s.max / mhz);
+  }
+  profiler.request_reset();
+}
+#else
+#define PROF_START(t)
+#define PROF_LAP(stage, t) \
+  do {                     \
+  } while (0)
+#endif
 
 /* ================= 工具函数 ================= */
 
+// I2C 单次传输的数据字节数 (与 Adafruit_SSD1306 的 WIRE_MAX 一致, 扣除控制字节)
+#if defined(I2C_BUFFER_LENGTH) && I2C_BUFFER_LENGTH < 256
+#define OLED_I2C_CHUNK (I2C_BUFFER_LENGTH - 1)
+#elif defined(I2C_BUFFER_LENGTH)
+#define OLED_I2C_CHUNK 255
+#else
+#define OLED_I2C_CHUNK 31
+#endif
+
+uint8_t oledShadow[SCREEN_WIDTH * SCREEN_HEIGHT / 8]; // 屏幕 GDDRAM 中当前的内容
+bool oledShadowValid = false;                         // oledShadow 是否与屏幕一致
+uint32_t i2cUs = 0;    // 累计 I2C 刷屏耗时 (统计用)
+uint32_t i2cBytes = 0; // 累计 I2C 发送的显示数据字节数 (统计用)
+
+// 刷新屏幕: 逐页 (8 行) 对比影子缓冲, 只用页/列地址命令发送变化的列区间
+void oledFlush() {
+  unsigned long t0 = micros();
+  uint8_t *buf = display.getBuffer();
+  if (!OLED_PARTIAL || !oledShadowValid) {
+    display.display();
+    memcpy(oledShadow, buf, sizeof(oledShadow));
+    oledShadowValid = true;
+    i2cBytes += sizeof(oledShadow);
+    i2cUs += micros() - t0;
+    return;
+  }
+
+  for (int page = 0; page < SCREEN_HEIGHT / 8; page++) {
+    uint8_t *row = buf + page * SCREEN_WIDTH;
+    uint8_t *old = oledShadow + page * SCREEN_WIDTH;
+    int c0 = 0;
+    while (c0 < SCREEN_WIDTH && row[c0] == old[c0]) {
+      c0++;
+    }
+    if (c0 == SCREEN_WIDTH) {
+      continue; // 本页无变化
+    }
+    int c1 = SCREEN_WIDTH - 1;
+    while (row[c1] == old[c1]) {
+      c1--;
+    }
+
+    display.ssd1306_command(SSD1306_PAGEADDR);
+    display.ssd1306_command(page);
+    display.ssd1306_command(page);
+    display.ssd1306_command(SSD1306_COLUMNADDR);
+    display.ssd1306_command(c0);
+    display.ssd1306_command(c1);
+    for (int c = c0; c <= c1; c += OLED_I2C_CHUNK) {
+      int n = c1 + 1 - c;
+      if (n > OLED_I2C_CHUNK) {
+        n = OLED_I2C_CHUNK;
+      }
+      Wire.beginTransmission(OLED_ADDR);
+      Wire.write((uint8_t)0x40); // Co = 0, D/C = 1: 后续均为显示数据
+      Wire.write(row + c, n);
+      Wire.endTransmission();
+    }
+    memcpy(old + c0, row + c0, c1 - c0 + 1);
+    i2cBytes += c1 - c0 + 1;
+  }
+  i2cUs += micros() - t0;
+}
+
 // 居中显示文字
 void displayCenterText(String text, int textSize, int yOffset = 0) {
+  bandScreenValid = false;
   display.clearDisplay();
   display.setTextSize(textSize);
   int16_t x1, y1;
@@ -74,29 +275,31 @@ void displayCenterText(String text, int textSize, int yOffset = 0) {
   display.getTextBounds(text, 0, 0, &x1, &y1, &w, &h);
   display.setCursor((SCREEN_WIDTH - w) / 2, (SCREEN_HEIGHT - h) / 2 + yOffset);
   display.print(text);
-  display.display();
+  oledFlush();
 }
 
-unsigned long startAttempt = 0;
-// 同步时间逻辑
-bool syncTime() {
+// 请求显示任务居中显示一条提示 (持续 showMsg 毫秒), 网络任务不直接操作屏幕
+void showMessage(const String &text) {
+  char msg[24];
+  snprintf(msg, sizeof(msg), "%s", text.c_str());
+  xQueueSend(messageQueue, msg, 0);
+}
 
-  if (startAttempt == 0) {
-    Serial.println("正在连接 Wi-Fi...");
-    isWifiConnecting = true;
-    WiFi.begin(ssid, password);
-    startAttempt = millis();
-  }
+// 同步时间逻辑 (在网络任务中执行, 阻塞等待不影响采集与显示)
+bool syncTime() {
+  Serial.println("正在连接 Wi-Fi...");
+  isWifiConnecting = true;
+  WiFi.begin(ssid, password);
+  unsigned long startAttempt = millis();
 
-  if (WiFi.status() != WL_CONNECTED && millis() - startAttempt < wifiTimeout * 1000) {
+  while (WiFi.status() != WL_CONNECTED && millis() - startAttempt < wifiTimeout * 1000) {
     Serial.print(".");
-    return false;
+    delay(450);
   }
 
-  if (WiFi.status() != WL_CONNECTED && millis() - startAttempt >= wifiTimeout * 1000) {
+  if (WiFi.status() != WL_CONNECTED) {
     Serial.println("\nWi-Fi 连接失败");
-    displayCenterText("Wi-Fi error", 1);
-    delay(showMsg);
+    showMessage("Wi-Fi error");
     WiFi.disconnect(true);
     isWifiConnecting = false;
     wifiFeatureEnabled = false; // 连接失败后禁用 WiFi 功能
@@ -106,8 +309,7 @@ bool syncTime() {
   Serial.println("\nWi-Fi connected");
   Serial.print("IP: ");
   Serial.println(WiFi.localIP());
-  displayCenterText(WiFi.localIP().toString(), 1);
-  delay(showMsg);
+  showMessage(WiFi.localIP().toString());
 
   Serial.println("正在同步时间...");
   configTime(8 * 3600, 0, ntpServer); // 设置东八区
@@ -115,8 +317,7 @@ bool syncTime() {
   struct tm timeinfo;
   if (!getLocalTime(&timeinfo)) {
     Serial.println("同步时间失败");
-    displayCenterText("async time error", 1);
-    delay(showMsg);
+    showMessage("async time error");
     WiFi.disconnect(true);
     isWifiConnecting = false;
     wifiFeatureEnabled = false; // 连接失败后禁用 WiFi 功能
@@ -137,6 +338,7 @@ void updateTimeDisplay() {
     return;
   }
 
+  bandScreenValid = false;
   display.clearDisplay();
   display.setFont(&FreeSans9pt7b); // 使用新字体
 
@@ -160,7 +362,7 @@ void updateTimeDisplay() {
   display.print(buf_s);
 
   display.setFont(); // 关键：渲染完时间后恢复默认字体，以免影响频谱模式
-  display.display();
+  oledFlush();
 }
 
 // 设置 OLED 对比度
@@ -169,74 +371,440 @@ void setOLEDContrast(uint8_t value) {
   display.ssd1306_command(value); // 0-255，值越小屏幕越暗
 }
 
-void showBand() {
-
-    // 更新峰值信息（由于原代码中是500ms更新一次显示，这里保留逻辑）
-    unsigned long now = millis();
-    if (now - lastPeakUpdate > peakTimeInterval) {
-      // 寻找频率
-      int frameBin = 0;
-      float fm = 0;
-      for (int i = 4; i < SAMPLES / 2; i++) {
-        if (vReal[i] > fm) {
-          fm = vReal[i];
-          frameBin = i;
-        }
-      }
-      maxDb = 20 * log10(fm + 1);
-      maxFreq = frameBin * (SAMPLING_FREQ / SAMPLES);
-      lastPeakUpdate = now;
+/* ================= 频谱分析 ================= */
+
+#if ANALYSIS_ENGINE == 1
+SlidingDftBank<float, Spectrum> sdftBank; // 每个频段一个滑动 DFT 滤波器
+
+// 逐个采样送入滤波器组, 读出各频段幅值并计算显示数据
+void analyzeHop(const int16_t *samples, BandFrame &out) {
+  PROF_START(t);
+  for (int i = 0; i < SDFT_HOP; i++) {
+    sdftBank.push(samples[i]);
+  }
+  PROF_LAP(PROF_FFT, t);
+  float amp[BAND_NUM];
+  float peakFreq;
+  float frameMax = sdftBank.magnitudes(amp, peakFreq);
+  PROF_LAP(PROF_MAGNITUDE, t);
+  bands.update(amp, frameMax, peakFreq, millis(), out);
+  PROF_LAP(PROF_BANDS, t);
+}
+#endif
+
+#if ANALYSIS_ENGINE == 2
+static_assert(BAND_NUM % OCTAVES == 0, "BAND_NUM 须为 OCTAVES 的整数倍");
+OctaveBank<float, OCTAVE_FS, OCTAVES, BAND_NUM / OCTAVES> octaveBank; // 逐级半带抽取 + 每级 32 点 FFT
+float octaveIn[AUDIO_CHUNK];
+int octavePending = 0; // 距上一帧已送入的采样数
+
+// 一块采样送入滤波器组, 每 FRAME_SAMPLES 个采样读出一帧, 返回是否有新帧
+bool analyzeOctave(const int16_t *samples, BandFrame &out) {
+  PROF_START(t);
+  for (int i = 0; i < AUDIO_CHUNK; i++) {
+    octaveIn[i] = samples[i];
+  }
+  octaveBank.push(octaveIn, AUDIO_CHUNK);
+  PROF_LAP(PROF_FFT, t);
+  octavePending += AUDIO_CHUNK;
+  if (octavePending < FRAME_SAMPLES) {
+    return false;
+  }
+  octavePending = 0;
+  float amp[BAND_NUM];
+  float peakFreq;
+  float frameMax = octaveBank.magnitudes(amp, peakFreq);
+  PROF_LAP(PROF_MAGNITUDE, t);
+  bands.update(amp, frameMax, peakFreq, millis(), out);
+  PROF_LAP(PROF_BANDS, t);
+  return true;
+}
+#endif
+
+// 采样不连续时清除跨块的状态, 避免把前后两段无关的音频拼进同一个 FFT 窗口或滤波器
+// (频段平滑与峰值下落不受影响, 显示照常衰减)
+void resetStream() {
+#if ANALYSIS_ENGINE == 1
+  sdftBank.reset();
+#elif ANALYSIS_ENGINE == 2
+  octaveBank.reset();
+  octavePending = 0;
+#else
+  sampleWindow.reset();
+  windowFill = 0;
+#endif
+}
+
+// 新采样并入窗口, FFT 并计算显示数据 (频段平滑、峰值下落、峰值频率)
+// 窗口中的连续采样不足 SAMPLES 个时 (启动或采样丢失后) 不输出, 返回 false
+bool analyzeFrame(const AudioFrame &in, BandFrame &out) {
+  sampleWindow.push(in.samples, AUDIO_CHUNK);
+  if (windowFill < SAMPLES) {
+    windowFill += AUDIO_CHUNK;
+    if (windowFill < SAMPLES) {
+      return false;
     }
+  }
+  PROF_START(t);
+#if FFT_Q15
+  sampleWindow.copy_to(qReal);
+  int32_t peak = qFFT.window(qReal);
+  PROF_LAP(PROF_WINDOW, t);
+  int shifts = qFFT.compute(qReal, peak);
+  PROF_LAP(PROF_FFT, t);
+  qFFT.magnitude(qReal, qMag, shifts);
+  for (int i = 0; i < FFT_SIZE / 2; i++) {
+    vReal[i] = qMag[i];
+  }
+#else
+  sampleWindow.copy_to(vReal);
+  FFT.window(vReal);
+  PROF_LAP(PROF_WINDOW, t);
+  FFT.compute(vReal);
+  PROF_LAP(PROF_FFT, t);
+  FFT.magnitude(vReal);
+#endif
+  PROF_LAP(PROF_MAGNITUDE, t);
 
-    // 绘制频谱显示 (此处复用您的原绘制逻辑)
-    display.clearDisplay();
-    display.setTextSize(1);
-    display.setCursor(0, 0);
-    display.printf("%4.1fdB", maxDb);
-    display.setCursor(42, 0);
-    display.printf("%4dHz", (int)maxFreq);
+  bands.process(vReal, millis(), out);
+  PROF_LAP(PROF_BANDS, t);
+  return true;
+}
+
+/* ================= 显示 ================= */
+
+// 频谱画面 (布局与增量绘制在 lib/spectrum/oled_band_view.h, 主机模拟器共用)
+OledBandView<Adafruit_SSD1306, BAND_NUM, SCREEN_WIDTH, SCREEN_HEIGHT, HEADER_H, BLOCK_HIGHT> bandView;
+
+void showBand(const BandFrame &f) {
+    PROF_START(t);
+
+    // 从其它界面切回时完整重绘
+    if (!bandScreenValid) {
+      display.clearDisplay();
+      bandView.reset();
+      bandScreenValid = true;
+    }
 
-    // --- 新增：右上角显示时间 ---
+    // 右上角时间精确到分钟
+    char timeText[12] = "";
     if (isTimeSynced) {
       struct tm timeinfo;
-      if (getLocalTime(&timeinfo)) {
-        display.setCursor(98, 0); // 靠近右侧边缘
-        display.printf("%02d:%02d", timeinfo.tm_hour, timeinfo.tm_min);
+      if (getLocalTime(&timeinfo, 0)) {
+        snprintf(timeText, sizeof(timeText), "%02d:%02d", timeinfo.tm_hour, timeinfo.tm_min);
       }
     }
+    bandView.draw(display, f, timeText);
+    PROF_LAP(PROF_RENDER, t);
+    oledFlush();
+    PROF_LAP(PROF_FLUSH, t);
+}
 
-    int barWidth = SCREEN_WIDTH / BAND_NUM;
-    for (int i = 0; i < BAND_NUM; i++) {
-      float maxAmp = 0;
-      for (int j = bin_indices[i]; j < bin_indices[i + 1]; j++)
-        if (vReal[j] > maxAmp) {
-          maxAmp = vReal[j];
-        }
-
-      float norm = constrain((maxAmp - noiseFloor) / 2048.0 * dbMult, 0, 1);
-      float db = norm * 100;
-      if (db > oldBandDb[i]) {
-        bandDb[i] = db * smoothUp + oldBandDb[i] * (1 - smoothUp);
-      } else {
-        bandDb[i] = db * smoothDown + oldBandDb[i] * (1 - smoothDown);
-      }
-      oldBandDb[i] = bandDb[i];
+// 显示一帧: 频谱/闲置状态机 (只在显示任务中调用)
+void renderFrame(const BandFrame &f) {
+  static unsigned long messageUntil = 0;
+  static unsigned long lastIdleDraw = 0;
+
+  // 网络任务的提示优先显示 showMsg 毫秒
+  char msg[24];
+  if (xQueueReceive(messageQueue, msg, 0) == pdTRUE) {
+    displayCenterText(msg, 1);
+    messageUntil = millis() + showMsg;
+  }
+  if ((long)(millis() - messageUntil) < 0) {
+    return;
+  }
+
+  if (currentMode == MODE_SPECTRUM) {
+    // --- 频谱模式 ---
+    showBand(f);
 
-      int totalHeight = map(bandDb[i], 0, 100, 0, SCREEN_HEIGHT - HEADER_H - 2);
-      int numBlocks = totalHeight / BLOCK_HIGHT;
-      for (int b = 0; b < numBlocks; b++) {
-        display.fillRect(i * barWidth, SCREEN_HEIGHT - (b + 1) * BLOCK_HIGHT, barWidth - 2, BLOCK_HIGHT - 2, SSD1306_WHITE);
+    // 闲置检测
+    if (f.currentDb < idleThreshold) {
+      if (lowVolumeStartTime == 0) {
+        lowVolumeStartTime = millis();
       }
-      if (bandDb[i] > peakDb[i]) {
-        peakDb[i] = bandDb[i];
-      } else {
-        peakDb[i] -= peakFall;
+      if (millis() - lowVolumeStartTime > idleDelay) {
+        Serial.println("声音持续过低，准备进入闲置模式...");
+        currentMode = MODE_IDLE_TIME;
+        lowVolumeStartTime = 0;
       }
-      int peakY = map(peakDb[i], 0, 100, SCREEN_HEIGHT, HEADER_H + 1);
-      peakY = constrain(peakY, HEADER_H + 1, SCREEN_HEIGHT - 1);
-      display.drawFastHLine(i * barWidth, peakY, barWidth - 2, SSD1306_WHITE);
+    } else {
+      lowVolumeStartTime = 0; // 声音恢复，重置计时器
     }
-    display.display();
+    return;
+  }
+
+  // --- 闲置/时间模式 ---
+
+  // 唤醒检测
+  if (f.currentDb > wakeupThreshold && !isWifiConnecting) {
+    Serial.printf("返回频谱模式... (%.1f dB)\n", f.currentDb);
+    currentMode = MODE_SPECTRUM;
+    return;
+  }
+
+  // 逻辑：判断是否已有时间
+  if (isTimeSynced) {
+    static unsigned long lastTimeUpdate = 0;
+    if (millis() - lastTimeUpdate >= 800) {
+      updateTimeDisplay();
+      lastTimeUpdate = millis();
+    }
+  } else if (!wifiFeatureEnabled) {
+    if (millis() - lastIdleDraw >= 450) {
+      displayCenterText("no sound", 1);
+      lastIdleDraw = millis();
+    }
+  } else {
+    // 需要尝试获取时间: 连接期间继续显示频谱
+    showBand(f);
+    if (!isWifiConnecting) {
+      isWifiConnecting = true;
+      xTaskNotifyGive(networkHandle);
+    }
+  }
+}
+
+/* ================= 音频采集 ================= */
+
+volatile uint32_t adcDroppedFrames = 0; // 缓存溢出丢失的采样帧 (统计用, 每秒清零)
+volatile uint32_t adcOverflows = 0;     // 缓存溢出次数 (不清零, 采集任务据此判断采样是否连续)
+
+#if ADC_DMA
+// ADC 连续模式: 硬件按 AUDIO_RATE 定时转换, DMA 每采满 AUDIO_CHUNK 个点产生一帧,
+// 驱动内部保存最多 ADC_FRAME_RING 帧, 取帧时 CPU 在信号量上阻塞而不是空转
+#define ADC_FRAME_BYTES (AUDIO_CHUNK * sizeof(adc_digi_output_data_t))
+
+uint8_t adcRaw[ADC_FRAME_BYTES]; // 一帧 DMA 原始结果
+int adcChannel = -1;             // MIC_ADC 对应的 ADC1 通道
+#if ESP_IDF_VERSION_MAJOR >= 5
+adc_continuous_handle_t adcHandle = NULL;
+
+// 驱动缓存已满 (处理跟不上采样), 新帧被丢弃
+static bool IRAM_ATTR adcPoolOverflow(adc_continuous_handle_t handle, const adc_continuous_evt_data_t *edata, void *user_data) {
+  adcDroppedFrames++;
+  adcOverflows++;
+  return false;
+}
+#endif
+
+void adcDmaInit() {
+  adcChannel = digitalPinToAnalogChannel(MIC_ADC);
+  if (adcChannel < 0 || adcChannel >= SOC_ADC_MAX_CHANNEL_NUM) {
+    Serial.println("MIC_ADC 不是 ADC1 引脚, 无法使用连续采样");
+    adcChannel = -1;
+    return;
+  }
+
+  adc_digi_pattern_config_t pattern = {};
+  pattern.atten = ADC_ATTEN_DB_11; // 与 analogRead 默认量程一致
+  pattern.channel = adcChannel;
+  pattern.unit = ADC_UNIT_1;
+  pattern.bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+
+#if ESP_IDF_VERSION_MAJOR >= 5
+  adc_continuous_handle_cfg_t handleCfg = {};
+  handleCfg.max_store_buf_size = ADC_FRAME_BYTES * ADC_FRAME_RING;
+  handleCfg.conv_frame_size = ADC_FRAME_BYTES;
+  ESP_ERROR_CHECK(adc_continuous_new_handle(&handleCfg, &adcHandle));
+
+  adc_continuous_config_t cfg = {};
+  cfg.pattern_num = 1;
+  cfg.adc_pattern = &pattern;
+  cfg.sample_freq_hz = AUDIO_RATE;
+  cfg.conv_mode = ADC_CONV_SINGLE_UNIT_1;
+  cfg.format = ADC_DIGI_OUTPUT_FORMAT_TYPE2;
+  ESP_ERROR_CHECK(adc_continuous_config(adcHandle, &cfg));
+
+  adc_continuous_evt_cbs_t cbs = {};
+  cbs.on_pool_ovf = adcPoolOverflow;
+  ESP_ERROR_CHECK(adc_continuous_register_event_callbacks(adcHandle, &cbs, NULL));
+  ESP_ERROR_CHECK(adc_continuous_start(adcHandle));
+#else
+  adc_digi_init_config_t initCfg = {};
+  initCfg.max_store_buf_size = ADC_FRAME_BYTES * ADC_FRAME_RING;
+  initCfg.conv_num_each_intr = ADC_FRAME_BYTES;
+  initCfg.adc1_chan_mask = BIT(adcChannel);
+  ESP_ERROR_CHECK(adc_digi_initialize(&initCfg));
+
+  adc_digi_configuration_t cfg = {};
+  cfg.conv_limit_en = 0;
+  cfg.pattern_num = 1;
+  cfg.adc_pattern = &pattern;
+  cfg.sample_freq_hz = AUDIO_RATE;
+  cfg.conv_mode = ADC_CONV_SINGLE_UNIT_1;
+  cfg.format = ADC_DIGI_OUTPUT_FORMAT_TYPE2;
+  ESP_ERROR_CHECK(adc_digi_controller_configure(&cfg));
+  ESP_ERROR_CHECK(adc_digi_start());
+#endif
+}
+
+// 从驱动缓存读取一帧原始结果, 超时返回 false
+bool adcReadFrame(uint32_t timeoutMs) {
+  uint32_t len = 0;
+#if ESP_IDF_VERSION_MAJOR >= 5
+  esp_err_t err = adc_continuous_read(adcHandle, adcRaw, ADC_FRAME_BYTES, &len, timeoutMs);
+#else
+  esp_err_t err = adc_digi_read_bytes(adcRaw, ADC_FRAME_BYTES, &len, timeoutMs);
+  if (err == ESP_ERR_INVALID_STATE) { // 缓存曾溢出, 数据仍然有效
+    adcDroppedFrames++;
+    adcOverflows++;
+    err = ESP_OK;
+  }
+#endif
+  return err == ESP_OK && len == ADC_FRAME_BYTES;
+}
+#endif
+
+// 音频采样函数 (DMA 模式下等待一帧就绪, 计算期间下一帧在后台继续采集)
+// 返回采样数据就绪的时刻, 之前的等待不计入采集任务的 CPU 占用
+unsigned long sampleAudio(int16_t *dst) {
+#if ADC_DMA
+  if (adcChannel >= 0) {
+    // 按顺序读取每一帧: 积压的帧也不跳过, 保证送入分析的采样连续
+    while (!adcReadFrame(portMAX_DELAY)) {
+    }
+    unsigned long ready = micros();
+    PROF_START(t);
+
+    const adc_digi_output_data_t *p = (const adc_digi_output_data_t *)adcRaw;
+    int last = 2048;
+    for (int i = 0; i < AUDIO_CHUNK; i++) {
+      if (p[i].type2.channel == adcChannel) {
+        last = p[i].type2.data;
+      }
+      dst[i] = last - 2048;
+    }
+    PROF_LAP(PROF_CAPTURE, t);
+    return ready;
+  }
+#endif
+
+  // analogRead 轮询: 忙等 micros() 控制采样间隔
+  unsigned long ready = micros();
+  unsigned long start = ready;
+  PROF_START(t);
+  for (int i = 0; i < AUDIO_CHUNK; i++) {
+    dst[i] = analogRead(MIC_ADC) - 2048;
+    while (micros() - start < delayMs) {
+    }
+    start += delayMs;
+  }
+  PROF_LAP(PROF_CAPTURE, t); // 轮询时包含忙等
+  return ready;
+}
+
+/* ================= 任务 ================= */
+
+// 各任务的忙碌时间 (不含阻塞等待), 每秒由 loop() 打印占用率
+enum TaskId { TASK_ACQUIRE, TASK_ANALYZE, TASK_RENDER, TASK_NETWORK, TASK_COUNT };
+const char *taskNames[TASK_COUNT] = {"acquire", "analyze", "render", "network"};
+TaskHandle_t taskHandles[TASK_COUNT];
+volatile uint32_t taskBusyUs[TASK_COUNT];
+volatile uint32_t renderFrames = 0;    // 每秒显示帧数 (统计用)
+volatile uint32_t audioDropped = 0;    // 分析跟不上而丢弃的采样帧
+volatile uint32_t frameSkipped = 0;    // 显示跟不上而跳过的频谱帧
+volatile UBaseType_t audioQueueMax = 0; // 统计周期内队列最大深度
+volatile UBaseType_t frameQueueMax = 0;
+
+void trackDepth(QueueHandle_t q, volatile UBaseType_t &maxDepth) {
+  UBaseType_t depth = uxQueueMessagesWaiting(q);
+  if (depth > maxDepth) {
+    maxDepth = depth;
+  }
+}
+
+// 采集任务: 按 AUDIO_RATE 取一块采样 (AUDIO_CHUNK 个) 送入 audioQueue
+void acquireTask(void *arg) {
+  AudioFrame frame;
+  bool polling = true;
+#if ADC_DMA
+  adcDmaInit();
+  polling = adcChannel < 0;
+#endif
+  if (polling) {
+    vTaskPrioritySet(NULL, 1); // analogRead 轮询会忙等, 降为最低优先级以免饿死分析/显示任务
+  }
+  bool lost = false;                 // 上一块未能送入 audioQueue
+  uint32_t seenOverflows = adcOverflows;
+  for (;;) {
+    unsigned long t0 = sampleAudio(frame.samples);
+    uint32_t overflows = adcOverflows;
+    frame.gap = lost || overflows != seenOverflows;
+    seenOverflows = overflows;
+    lost = xQueueSend(audioQueue, &frame, 0) != pdTRUE;
+    if (lost) {
+      audioDropped++;
+    }
+    trackDepth(audioQueue, audioQueueMax);
+    taskBusyUs[TASK_ACQUIRE] += micros() - t0;
+    if (polling) {
+      vTaskDelay(1); // 让出 CPU 给空闲任务 (任务看门狗)
+    }
+  }
+}
+
+void sendFrame(const BandFrame &f) {
+  if (xQueueSend(frameQueue, &f, 0) != pdTRUE) {
+    frameSkipped++;
+  }
+  trackDepth(frameQueue, frameQueueMax);
+}
+
+// 分析任务: FFT (或滑动 DFT / 八度滤波器组) 与频段计算, 结果送入 frameQueue
+void analyzeTask(void *arg) {
+  AudioFrame in;
+  BandFrame out;
+  for (;;) {
+    xQueueReceive(audioQueue, &in, portMAX_DELAY);
+    unsigned long t0 = micros();
+    if (in.gap) {
+      resetStream();
+    }
+#if ANALYSIS_ENGINE == 1
+    for (int i = 0; i < SAMPLES; i += SDFT_HOP) {
+      analyzeHop(in.samples + i, out);
+      sendFrame(out);
+    }
+#elif ANALYSIS_ENGINE == 2
+    if (analyzeOctave(in.samples, out)) {
+      sendFrame(out);
+    }
+#else
+    if (analyzeFrame(in, out)) {
+      sendFrame(out);
+    }
+#endif
+    taskBusyUs[TASK_ANALYZE] += micros() - t0;
+  }
+}
+
+// 显示任务: 只绘制队列中最新的一帧, 独占屏幕与 I2C
+void renderTask(void *arg) {
+  BandFrame f;
+  for (;;) {
+    if (xQueueReceive(frameQueue, &f, pdMS_TO_TICKS(100)) != pdTRUE) {
+      continue;
+    }
+    unsigned long t0 = micros();
+    while (xQueueReceive(frameQueue, &f, 0) == pdTRUE) {
+      frameSkipped++;
+    }
+    renderFrame(f);
+    renderFrames++;
+    taskBusyUs[TASK_RENDER] += micros() - t0;
+  }
+}
+
+// 网络任务: 等待显示任务通知后连接 WiFi 并同步时间
+void networkTask(void *arg) {
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    unsigned long t0 = micros();
+    syncTime();
+    taskBusyUs[TASK_NETWORK] += micros() - t0;
+  }
 }
 
 /* ================= Setup & Loop ================= */
@@ -244,6 +812,19 @@ void showBand() {
 void setup() {
   Serial.begin(115200);
 
+#if SPECTRUM_BENCH
+  delay(2000); // 等待 USB 串口连接
+  HotPathBench b = run_hotpath_bench<float, BAND_NUM, SCREEN_HEIGHT - HEADER_H - 2, BLOCK_HIGHT, HEADER_H + 1, SCREEN_HEIGHT>(
+      [] { return (uint32_t)ESP.getCycleCount(); });
+  Serial.printf("hot path cycles/frame: log10+map %u  fast_db+LUT %u  mismatches %d\n", b.referencePerFrame,
+                b.fastPerFrame, b.mismatches);
+  EngineBench e = run_engine_bench<float, Spectrum>([] { return (uint32_t)ESP.getCycleCount(); }, SDFT_HOP);
+  Serial.printf("engine cycles/%d samples: fft %u  sdft %u\n", SAMPLES, e.fftPerBlock, e.sdftPerBlock);
+  uint32_t oct = run_octave_bench<float, Spectrum, OctaveBank<float, OCTAVE_FS, OCTAVES, BAND_NUM / OCTAVES>>(
+      [] { return (uint32_t)ESP.getCycleCount(); });
+  Serial.printf("octave bank cycles/frame (%dHz, %d bands): %u\n", OCTAVE_FS, BAND_NUM, oct);
+#endif
+
 #ifdef OLED_GND
   pinMode(OLED_GND, OUTPUT);
   digitalWrite(OLED_GND, LOW);
@@ -265,84 +846,50 @@ void setup() {
 #endif
 
   Wire.begin(OLED_SDA, OLED_SCK);
-  display.begin(SSD1306_SWITCHCAPVCC, 0x3C);
+  display.begin(SSD1306_SWITCHCAPVCC, OLED_ADDR);
   display.setTextColor(SSD1306_WHITE);
   display.clearDisplay();
-  display.display();
+  oledFlush();
 
   setOLEDContrast(10);
+
+  audioQueue = xQueueCreate(AUDIO_QUEUE_LEN, sizeof(AudioFrame));
+  frameQueue = xQueueCreate(FRAME_QUEUE_LEN, sizeof(BandFrame));
+  messageQueue = xQueueCreate(2, 24);
+  xTaskCreatePinnedToCore(acquireTask, "acquire", 3072, NULL, 5, &taskHandles[TASK_ACQUIRE], AUDIO_CORE);
+  xTaskCreatePinnedToCore(analyzeTask, "analyze", 4096, NULL, 4, &taskHandles[TASK_ANALYZE], AUDIO_CORE);
+  xTaskCreatePinnedToCore(renderTask, "render", 4096, NULL, 2, &taskHandles[TASK_RENDER], UI_CORE);
+  xTaskCreatePinnedToCore(networkTask, "network", 4096, NULL, 1, &taskHandles[TASK_NETWORK], UI_CORE);
+  networkHandle = taskHandles[TASK_NETWORK];
 }
 
+// loop() 只负责每秒打印一次统计: 各任务 CPU 占用与剩余栈, 队列深度, 帧率与丢帧
 void loop() {
-
-  // FFT 核心逻辑
-  unsigned long start = micros();
-  for (int i = 0; i < SAMPLES; i++) {
-    vReal[i] = (float)analogRead(MIC_ADC) - 2048.0;
-    vImag[i] = 0;
-    while (micros() - start < delayMs) {
-    }
-    start += delayMs;
-  }
-
-  FFT.windowing(FFTWindow::Hamming, FFTDirection::Forward);
-  FFT.compute(FFTDirection::Forward);
-  FFT.complexToMagnitude();
-
-  // 计算当前帧最大分贝
-  float frameMax = 0;
-  for (int i = 4; i < SAMPLES / 2; i++) {
-    if (vReal[i] > frameMax) {
-      frameMax = vReal[i];
-    }
-  }
-  float currentDb = 20 * log10(frameMax + 1);
-
-  // 2. 状态机逻辑
-  if (currentMode == MODE_SPECTRUM) {
-    // --- 频谱模式 ---
-    showBand();
-
-    // 闲置检测
-    if (currentDb < idleThreshold) {
-      if (lowVolumeStartTime == 0) {
-        lowVolumeStartTime = millis();
-      }
-      if (millis() - lowVolumeStartTime > idleDelay) {
-        Serial.println("声音持续过低，准备进入闲置模式...");
-        currentMode = MODE_IDLE_TIME;
-        lowVolumeStartTime = 0;
-      }
-    } else {
-      lowVolumeStartTime = 0; // 声音恢复，重置计时器
-    }
-
-  } else {
-    // --- 闲置/时间模式 ---
-
-    // 唤醒检测
-    if (currentDb > wakeupThreshold && !isWifiConnecting) {
-      Serial.printf("返回频谱模式... (%.1f dB)\n", currentDb);
-      currentMode = MODE_SPECTRUM;
-      return;
-    }
-
-    // 逻辑：判断是否已有时间
-    if (isTimeSynced) {
-      static unsigned long lastTimeUpdate = 0;
-      if (millis() - lastTimeUpdate >= 800) {
-        updateTimeDisplay();
-        lastTimeUpdate = millis();
-      }
-    } else {
-      // 需要尝试获取时间
-      if (!wifiFeatureEnabled) {
-        displayCenterText("no sound", 1);
-      } else {
-        showBand();
-        syncTime();
-      }
-    }
-    delay(450);
+  static unsigned long lastStat = micros();
+  delay(1000);
+  unsigned long now = micros();
+  float onePercentUs = (now - lastStat) / 100.0;
+  lastStat = now;
+
+  Serial.printf("fps %u  i2c %uus %uB/frame", renderFrames,
+                renderFrames ? i2cUs / renderFrames : 0, renderFrames ? i2cBytes / renderFrames : 0);
+  Serial.printf("  queue audio %u/%u frame %u/%u", uxQueueMessagesWaiting(audioQueue), audioQueueMax,
+                uxQueueMessagesWaiting(frameQueue), frameQueueMax);
+  Serial.printf("  dropped adc %u audio %u frame %u\n", adcDroppedFrames, audioDropped, frameSkipped);
+  for (int t = 0; t < TASK_COUNT; t++) {
+    Serial.printf("  %-8s cpu %5.1f%%  stack free %u\n", taskNames[t], taskBusyUs[t] / onePercentUs,
+                  uxTaskGetStackHighWaterMark(taskHandles[t]));
+    taskBusyUs[t] = 0;
   }
-}
\ No newline at end of file
+  renderFrames = 0;
+  i2cUs = 0;
+  i2cBytes = 0;
+  adcDroppedFrames = 0;
+  audioDropped = 0;
+  frameSkipped = 0;
+  audioQueueMax = 0;
+  frameQueueMax = 0;
+#if STAGE_PROFILE
+  printProfile();
+#endif
+}
@@ -0,0 +1,43 @@
+# 编译前把 web/index.html 压缩为 src/index_html_gz.h (PlatformIO extra_scripts = pre:gzip_web.py)
+# 也可以直接运行: python gzip_web.py
+import gzip
+import hashlib
+import os
+
+try:
+    Import("env")  # noqa: F821
+    ROOT = env["PROJECT_DIR"]  # noqa: F821
+except NameError:
+    ROOT = os.path.dirname(os.path.abspath(__file__))
+
+SRC = os.path.join(ROOT, "web", "index.html")
+DST = os.path.join(ROOT, "src", "index_html_gz.h")
+
+with open(SRC, "rb") as f:
+    html = f.read()
+gz = gzip.compress(html, compresslevel=9, mtime=0)  # mtime=0: 内容不变时输出不变
+etag = hashlib.sha1(gz).hexdigest()[:16]
+
+lines = [
+    "// 由 gzip_web.py 从 web/index.html 生成, 不要手动修改",
+    "#pragma once",
+    "#include <Arduino.h>",
+    "",
+    '#define INDEX_HTML_ETAG "\\"%s\\""' % etag,
+    "#define INDEX_HTML_GZ_LEN %d // 原始 %d 字节" % (len(gz), len(html)),
+    "",
+    "const uint8_t INDEX_HTML_GZ[] PROGMEM = {",
+]
+for i in range(0, len(gz), 16):
+    lines.append("  " + ", ".join("0x%02x" % b for b in gz[i:i + 16]) + ",")
+lines.append("};")
+text = "\n".join(lines) + "\n"
+
+old = None
+if os.path.exists(DST):
+    with open(DST) as f:
+        old = f.read()
+if old != text:
+    with open(DST, "w") as f:
+        f.write(text)
+    print("gzip_web.py: %s (%d -> %d bytes)" % (os.path.relpath(DST, ROOT), len(html), len(gz)))
@@ -0,0 +1,107 @@
+// 由 gzip_web.py 从 web/index.html 生成, 不要手动修改
+#pragma once
+#include <Arduino.h>
+
+#define INDEX_HTML_ETAG "\"e297f60a07a80401\""
+#define INDEX_HTML_GZ_LEN 1564 // 原始 3443 字节
+
+const uint8_t INDEX_HTML_GZ[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xad, 0x57, 0xdb, 0x6e, 0xd4, 0x46,
+  0x18, 0xbe, 0xdf, 0xa7, 0x98, 0x1a, 0x55, 0xec, 0x22, 0x7b, 0xd7, 0xbb, 0x39, 0xe2, 0x3d, 0x5c,
+  0x00, 0x41, 0x20, 0xd1, 0x10, 0x91, 0x70, 0xc1, 0xe5, 0xd8, 0x1e, 0xaf, 0x87, 0xd8, 0x9e, 0x95,
+  0x3d, 0x9b, 0x64, 0x59, 0x45, 0xaa, 0xd4, 0x42, 0x11, 0x17, 0x85, 0xaa, 0x40, 0x5b, 0x0e, 0x82,
+  0xd2, 0xaa, 0xa0, 0xaa, 0xa5, 0x51, 0xd5, 0x82, 0x80, 0xb6, 0x48, 0x7d, 0x16, 0x76, 0x43, 0xee,
+  0xfa, 0x08, 0xfd, 0x67, 0xc6, 0xeb, 0x78, 0x37, 0x49, 0x85, 0x2a, 0x6e, 0xb2, 0x33, 0xff, 0xf1,
+  0xfb, 0x8f, 0xe3, 0x34, 0x3e, 0x38, 0x71, 0xf6, 0xf8, 0xca, 0x85, 0xa5, 0x05, 0xe4, 0xf3, 0x30,
+  0x68, 0x35, 0xc4, 0x5f, 0x14, 0xe0, 0xa8, 0xdd, 0xd4, 0x2e, 0xf9, 0xc6, 0xf1, 0x45, 0x0d, 0x48,
+  0x04, 0xbb, 0xad, 0x46, 0x48, 0x38, 0x46, 0x8e, 0x8f, 0xe3, 0x84, 0xf0, 0xa6, 0x76, 0x7e, 0xe5,
+  0xa4, 0x31, 0xaf, 0xa5, 0xd4, 0x08, 0x87, 0xa4, 0xa9, 0xad, 0x51, 0xb2, 0xde, 0x61, 0x31, 0xd7,
+  0x90, 0xc3, 0x22, 0x4e, 0x22, 0x90, 0x5a, 0xa7, 0x2e, 0xf7, 0x9b, 0x2e, 0x59, 0xa3, 0x0e, 0x31,
+  0xe4, 0x45, 0x47, 0x34, 0xa2, 0x9c, 0xe2, 0xc0, 0x48, 0x1c, 0x1c, 0x90, 0x66, 0x55, 0x6b, 0x15,
+  0x1a, 0x9c, 0xf2, 0x80, 0xb4, 0x16, 0x96, 0x97, 0xa6, 0x6a, 0xe8, 0xec, 0x99, 0x85, 0x13, 0x68,
+  0xf8, 0xf9, 0xe3, 0xc1, 0xd5, 0x67, 0x83, 0xeb, 0x5b, 0x8d, 0x8a, 0xe2, 0x15, 0x1a, 0x09, 0xef,
+  0x89, 0xdf, 0xca, 0x11, 0x34, 0xbc, 0xf7, 0xd3, 0xe0, 0xde, 0xd6, 0xf0, 0xe1, 0xf3, 0xc1, 0x1f,
+  0xd7, 0x51, 0xf1, 0xcd, 0xab, 0xef, 0x86, 0x77, 0x5f, 0xa3, 0x63, 0x8c, 0xf1, 0x84, 0xc7, 0xb8,
+  0x83, 0x8e, 0x9f, 0x58, 0xd4, 0xd1, 0xe0, 0xfa, 0x8f, 0x6f, 0x5e, 0xdf, 0xdf, 0xbe, 0xf5, 0x0d,
+  0x08, 0xef, 0x7c, 0xfb, 0xfb, 0xf6, 0xcd, 0x27, 0x83, 0xab, 0x5b, 0xdb, 0x77, 0x3e, 0xdd, 0xf9,
+  0x04, 0x0e, 0x57, 0x4a, 0xe8, 0x48, 0xa5, 0x70, 0xa4, 0x6f, 0xb3, 0x0d, 0x23, 0xa1, 0x97, 0x68,
+  0xd4, 0xb6, 0x6c, 0x16, 0xbb, 0x24, 0x36, 0x80, 0xb2, 0x59, 0xb0, 0x99, 0xdb, 0xeb, 0x87, 0x38,
+  0x6e, 0xd3, 0xc8, 0x32, 0xeb, 0x1e, 0xc4, 0x62, 0x78, 0x38, 0xa4, 0x41, 0xcf, 0x4a, 0x7a, 0x09,
+  0x27, 0xa1, 0xd1, 0xa5, 0xba, 0x81, 0x3b, 0x9d, 0x80, 0x18, 0x8a, 0xa0, 0x6b, 0xcb, 0xa4, 0xcd,
+  0x08, 0x3a, 0x7f, 0x5a, 0xd3, 0xcf, 0x31, 0x9b, 0x71, 0xa6, 0x6b, 0xa7, 0x48, 0xb0, 0x46, 0x38,
+  0x75, 0x30, 0x5a, 0x24, 0x5d, 0xa2, 0xe9, 0xda, 0x22, 0x90, 0xd1, 0x32, 0x8e, 0x12, 0x38, 0x2f,
+  0x81, 0xcb, 0x93, 0x90, 0x62, 0xb4, 0x7c, 0x1c, 0x6e, 0x1f, 0x51, 0x27, 0x66, 0x09, 0xf3, 0x38,
+  0xba, 0x80, 0x4f, 0x11, 0xaa, 0xe9, 0x09, 0x48, 0x19, 0x09, 0x89, 0xa9, 0xa7, 0xbc, 0x03, 0x46,
+  0x62, 0x55, 0x63, 0x12, 0xd6, 0x03, 0x1a, 0x11, 0xc3, 0x27, 0xb4, 0xed, 0x73, 0xab, 0x5a, 0x9e,
+  0xa9, 0x3b, 0x2c, 0x60, 0xb1, 0x75, 0xa8, 0x56, 0xad, 0xcd, 0xd4, 0x8e, 0xd6, 0x6d, 0xec, 0xac,
+  0xb6, 0x63, 0xd6, 0x8d, 0x5c, 0xeb, 0x90, 0x37, 0xef, 0x1d, 0xf5, 0xf0, 0x66, 0xa1, 0x2c, 0x6a,
+  0x81, 0x41, 0x2d, 0x86, 0x90, 0x36, 0x54, 0x0d, 0xac, 0x99, 0x69, 0xb3, 0xb3, 0x51, 0x4f, 0x43,
+  0x04, 0x3b, 0x60, 0x1a, 0xe1, 0x2e, 0xe0, 0x33, 0xeb, 0x1d, 0xec, 0xba, 0x22, 0x21, 0x26, 0x2a,
+  0xcf, 0x09, 0xfa, 0x66, 0xc1, 0x9f, 0xce, 0x92, 0x81, 0x4c, 0x24, 0x61, 0xe4, 0x50, 0x49, 0x65,
+  0x45, 0x58, 0x57, 0xb8, 0x66, 0x4c, 0x73, 0x02, 0x67, 0x0d, 0x60, 0x84, 0xb6, 0x31, 0x95, 0xda,
+  0x81, 0x2c, 0x73, 0xce, 0x42, 0x19, 0x11, 0x70, 0x3c, 0x16, 0x87, 0x46, 0x80, 0x6d, 0x12, 0xf4,
+  0x5d, 0x9a, 0x74, 0x02, 0xdc, 0xb3, 0x68, 0x24, 0x0d, 0xd8, 0x01, 0x73, 0x56, 0xeb, 0xe3, 0x4a,
+  0xe5, 0x99, 0x9c, 0x96, 0x88, 0x2d, 0x66, 0x81, 0xae, 0x6e, 0x09, 0x09, 0x88, 0xc3, 0x33, 0x23,
+  0x4a, 0x5b, 0x05, 0x5c, 0x35, 0xcd, 0x0f, 0xb3, 0xd0, 0xca, 0x53, 0x32, 0xb2, 0x34, 0x40, 0x89,
+  0x1d, 0x3c, 0xfa, 0x90, 0x6f, 0x9e, 0x26, 0x74, 0x74, 0x1b, 0x4b, 0xa8, 0xe7, 0xd5, 0x55, 0x97,
+  0x58, 0xd5, 0xce, 0x06, 0x4a, 0x58, 0x40, 0x5d, 0x74, 0xc8, 0x25, 0xa4, 0x46, 0x66, 0x53, 0x86,
+  0x11, 0x63, 0x97, 0x76, 0x93, 0x91, 0x83, 0x09, 0x94, 0x96, 0xc7, 0x9c, 0x6e, 0x32, 0x86, 0x55,
+  0x91, 0xfa, 0xac, 0xcb, 0x45, 0xbc, 0xd0, 0x6c, 0xa9, 0x9d, 0xb4, 0xac, 0xf3, 0xb3, 0xf6, 0x9c,
+  0x47, 0xea, 0xb2, 0x4d, 0x7d, 0xec, 0xb2, 0x75, 0x59, 0x01, 0xa8, 0x4c, 0x4d, 0xe2, 0x8f, 0xdb,
+  0x36, 0x2e, 0x56, 0xa7, 0xf4, 0x6a, 0xd5, 0xd4, 0x6b, 0x33, 0x53, 0x3a, 0x90, 0x4b, 0x9b, 0x05,
+  0x4e, 0x36, 0x38, 0x8e, 0x09, 0x1e, 0xf3, 0xdd, 0x0f, 0x21, 0x83, 0x69, 0x3d, 0x66, 0x45, 0xd0,
+  0x31, 0x91, 0xe5, 0x5b, 0x23, 0xb1, 0xe8, 0xd1, 0x20, 0x83, 0xea, 0x13, 0x67, 0x35, 0xcb, 0xa0,
+  0x17, 0x90, 0x8d, 0x3a, 0x0e, 0x68, 0x3b, 0x32, 0x28, 0xb4, 0x79, 0x62, 0x39, 0x30, 0xd4, 0x24,
+  0xae, 0xb7, 0x71, 0x67, 0xa2, 0x0e, 0x42, 0x0d, 0x06, 0xbb, 0xd3, 0xe5, 0xfd, 0x34, 0xe1, 0xc2,
+  0xc9, 0xa8, 0x01, 0xc4, 0x79, 0xd4, 0x42, 0xa0, 0x62, 0xf3, 0xe8, 0x7d, 0x14, 0x49, 0x55, 0x24,
+  0x57, 0x21, 0xd3, 0x9d, 0x25, 0x9e, 0xbb, 0x4f, 0x91, 0xc6, 0x18, 0x13, 0x45, 0xaa, 0x3b, 0xdd,
+  0x38, 0x01, 0x6b, 0x1d, 0x46, 0x45, 0x6c, 0x0a, 0x9e, 0xe5, 0x33, 0xc8, 0x4c, 0x7f, 0xcc, 0xb8,
+  0x3d, 0x43, 0xdc, 0x39, 0x60, 0xc3, 0xd2, 0x8a, 0xf9, 0xa8, 0x93, 0x39, 0xeb, 0x58, 0x55, 0x30,
+  0x32, 0x42, 0x2d, 0x43, 0x4d, 0xe1, 0x99, 0x78, 0x6a, 0xb6, 0x56, 0x1b, 0x43, 0xe8, 0x56, 0xc9,
+  0x9c, 0xbb, 0x1f, 0x42, 0x3c, 0xe5, 0x78, 0xb6, 0x7d, 0x60, 0x1b, 0xb9, 0x46, 0xc4, 0x22, 0x92,
+  0x25, 0x4d, 0x5c, 0x36, 0x0b, 0x8d, 0x8a, 0x5a, 0x89, 0x8d, 0x8a, 0xdc, 0xcf, 0x85, 0x86, 0xd8,
+  0x5b, 0xf0, 0xe3, 0xd2, 0x35, 0xe4, 0x04, 0x38, 0x49, 0x9a, 0x5a, 0x36, 0xfb, 0xb0, 0x64, 0x11,
+  0x6a, 0xf8, 0xd3, 0xad, 0x7f, 0x1e, 0x7c, 0xf9, 0x20, 0xbf, 0x62, 0x77, 0xee, 0x3f, 0x1a, 0xde,
+  0x7f, 0x0d, 0x26, 0xa6, 0xa5, 0x84, 0xa8, 0x26, 0xa2, 0x2e, 0x68, 0x7a, 0xed, 0x93, 0x70, 0x96,
+  0x7a, 0x40, 0xcf, 0xd9, 0x14, 0x83, 0x9c, 0x92, 0x81, 0x21, 0xe7, 0x76, 0xc4, 0xda, 0x9d, 0x64,
+  0xad, 0x35, 0x7c, 0xf8, 0xd9, 0xce, 0xa3, 0xaf, 0x1b, 0x15, 0x79, 0xcd, 0xc4, 0x65, 0x8b, 0x8c,
+  0x89, 0xa7, 0x0d, 0xaa, 0x49, 0xaf, 0x72, 0xd7, 0x8f, 0x7c, 0x56, 0xc0, 0xe9, 0xff, 0x76, 0x3f,
+  0xb8, 0x72, 0x79, 0xf0, 0xf4, 0xc5, 0xa4, 0xfb, 0xd1, 0x6c, 0x1c, 0x8c, 0x20, 0x7d, 0xb9, 0x34,
+  0x14, 0xb3, 0x75, 0x10, 0x98, 0x86, 0x17, 0xae, 0x32, 0xd2, 0x7a, 0x1f, 0xb8, 0x86, 0xb7, 0x5f,
+  0x0c, 0x6e, 0x7c, 0x31, 0x89, 0x4b, 0x6d, 0x83, 0x31, 0x79, 0x45, 0x52, 0xa0, 0x62, 0xc6, 0x33,
+  0xd3, 0x20, 0xcd, 0x3a, 0x9c, 0xb2, 0x08, 0xad, 0xe1, 0xa0, 0x0b, 0xaf, 0xae, 0xa9, 0xb5, 0xcc,
+  0xbf, 0xe1, 0x9d, 0x54, 0xd4, 0x03, 0xc5, 0xe0, 0x9d, 0x3d, 0xfa, 0x2e, 0x72, 0x35, 0xad, 0x55,
+  0x9d, 0x7f, 0x17, 0x41, 0x88, 0xb6, 0x36, 0xb7, 0x8f, 0x20, 0xb4, 0xa5, 0x84, 0xfe, 0x5e, 0xb2,
+  0xf5, 0xea, 0xce, 0xe0, 0xda, 0x93, 0x9d, 0x8f, 0x1f, 0x0c, 0x5e, 0xfe, 0x80, 0x8a, 0x61, 0x82,
+  0x86, 0xb7, 0xb6, 0x06, 0x3f, 0x7f, 0xf5, 0xf6, 0xd9, 0xb5, 0xc1, 0xf7, 0x8f, 0x15, 0x13, 0xce,
+  0xc3, 0xcb, 0x8f, 0x4a, 0xfb, 0x37, 0x1a, 0xef, 0x75, 0x00, 0x69, 0xd4, 0x0d, 0x6d, 0x18, 0x81,
+  0x83, 0x8b, 0x9e, 0x74, 0x08, 0x71, 0xff, 0xbb, 0xed, 0x72, 0x6b, 0x6e, 0x1c, 0x7b, 0xde, 0x91,
+  0xe4, 0xc3, 0xb6, 0x4e, 0xad, 0xc2, 0xab, 0x1e, 0x04, 0x2b, 0xd0, 0x3c, 0x13, 0x91, 0xb6, 0x06,
+  0x37, 0x7e, 0x81, 0x0f, 0x12, 0x85, 0x7f, 0x0c, 0x78, 0xde, 0xb9, 0xdd, 0x85, 0xf7, 0x2e, 0x4a,
+  0x2d, 0xab, 0x4b, 0x16, 0x02, 0xac, 0x28, 0x0d, 0xb1, 0xc8, 0x09, 0xa8, 0xb3, 0xda, 0xd4, 0xc4,
+  0xa7, 0x48, 0xaf, 0x58, 0x82, 0xa6, 0x7f, 0x79, 0x13, 0xec, 0xbe, 0x7d, 0xfa, 0xd7, 0xf6, 0x9f,
+  0x4f, 0x1b, 0x15, 0xa5, 0x23, 0xc7, 0xba, 0x22, 0xe0, 0xcb, 0x93, 0x08, 0x49, 0x80, 0x0b, 0x93,
+  0x76, 0x66, 0x4d, 0x6e, 0x34, 0xa4, 0x76, 0x8c, 0xd6, 0x52, 0xea, 0x83, 0xe7, 0xbf, 0x0e, 0xef,
+  0xfe, 0x36, 0xbc, 0xbd, 0x95, 0x42, 0x1a, 0xfd, 0x40, 0x50, 0xb4, 0x03, 0xb5, 0xf5, 0xba, 0x91,
+  0x23, 0xbb, 0x21, 0x60, 0xd8, 0x5d, 0xe6, 0x98, 0x77, 0x93, 0x62, 0x09, 0xf5, 0xc1, 0x85, 0x47,
+  0xb8, 0xe3, 0x17, 0x0f, 0xc3, 0x72, 0x12, 0xc4, 0xc3, 0x25, 0x19, 0x4d, 0x99, 0xfb, 0x24, 0x2a,
+  0xc6, 0xa8, 0xd9, 0x42, 0x71, 0xf9, 0x62, 0xc2, 0xa2, 0x62, 0x29, 0xcf, 0xb8, 0x28, 0x18, 0xfd,
+  0x34, 0x49, 0x72, 0x09, 0x94, 0x65, 0x97, 0xa1, 0x26, 0xba, 0x58, 0x96, 0xf7, 0x7a, 0xca, 0x4c,
+  0xe7, 0x33, 0xc7, 0x1e, 0x51, 0x78, 0x4c, 0xc3, 0x62, 0x69, 0x24, 0x07, 0x23, 0x93, 0x93, 0x81,
+  0xdb, 0x88, 0x21, 0x6b, 0x9d, 0x63, 0xc9, 0x7b, 0xc6, 0xcc, 0x4a, 0x56, 0x96, 0xb5, 0x24, 0xae,
+  0x92, 0xc9, 0xc8, 0x4a, 0x70, 0x13, 0xdc, 0x6c, 0xee, 0xa6, 0x20, 0xcd, 0xbf, 0x0c, 0x00, 0xd0,
+  0x24, 0x90, 0x4b, 0x0c, 0x1f, 0xc5, 0x4d, 0x14, 0x91, 0x75, 0x74, 0xfe, 0xdc, 0x99, 0x65, 0x82,
+  0x63, 0xc7, 0x5f, 0xc2, 0x31, 0x0e, 0x13, 0x85, 0x50, 0xf0, 0xcb, 0xa0, 0x46, 0x22, 0xb7, 0x98,
+  0x2e, 0x3d, 0x3d, 0x1f, 0xf7, 0x5e, 0xa1, 0xd1, 0x5e, 0xd2, 0xc7, 0x33, 0x90, 0x46, 0xbd, 0x57,
+  0x5e, 0xac, 0x0c, 0x7d, 0x37, 0x0b, 0x7b, 0x05, 0x54, 0xcf, 0xeb, 0xf9, 0x7c, 0x48, 0x21, 0xea,
+  0xa1, 0xe2, 0xde, 0x34, 0x94, 0x26, 0x94, 0x77, 0x5b, 0x5b, 0x47, 0xb0, 0x5a, 0xa4, 0xa6, 0x2a,
+  0xbc, 0x06, 0xe3, 0x2f, 0xa8, 0x7d, 0x04, 0xff, 0x19, 0xf8, 0xcc, 0xb5, 0x90, 0xb6, 0x74, 0x76,
+  0x79, 0x05, 0x28, 0xe2, 0x79, 0xb2, 0x54, 0x6a, 0x36, 0xdf, 0xa9, 0x2b, 0x20, 0xa5, 0xb9, 0xb6,
+  0x50, 0x99, 0x85, 0xbe, 0x85, 0xc4, 0xba, 0xf0, 0xd9, 0x14, 0x8a, 0x24, 0xb4, 0x09, 0x5f, 0x08,
+  0x88, 0x38, 0x1e, 0xeb, 0x9d, 0x06, 0x60, 0xa2, 0xad, 0xb3, 0x1e, 0x80, 0x4b, 0x59, 0xb6, 0xf8,
+  0x19, 0x9a, 0xf0, 0x32, 0xbc, 0xa4, 0xf0, 0xa8, 0x17, 0xb5, 0xb4, 0xcf, 0x33, 0x29, 0x80, 0xbb,
+  0x42, 0x43, 0x02, 0xdf, 0x60, 0xa9, 0xc3, 0x71, 0x35, 0x78, 0xd8, 0x77, 0x75, 0x74, 0x54, 0x33,
+  0x4d, 0xb3, 0x94, 0xef, 0x82, 0x75, 0x1a, 0xc1, 0x87, 0x59, 0x99, 0x45, 0x62, 0x10, 0x00, 0xda,
+  0xee, 0x3c, 0xd4, 0xc5, 0x0b, 0xad, 0xc6, 0x05, 0x86, 0x51, 0xbc, 0xcd, 0xf0, 0xcc, 0x8a, 0x7f,
+  0xb1, 0x0a, 0xff, 0x02, 0xc9, 0x06, 0x6c, 0xe8, 0x73, 0x0d, 0x00, 0x00,
+};
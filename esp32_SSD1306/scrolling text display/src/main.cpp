@@ -4,8 +4,63 @@
 #include <U8g2lib.h>
 #include <time.h>
 #include <ArduinoJson.h>
-#include <WebServer.h>
-WebServer server(80);
+#include <ESPAsyncWebServer.h>
+#include <LittleFS.h>
+#include <stage_profiler.h>
+#include "index_html_gz.h"   // 由 gzip_web.py 从 web/index.html 生成
+AsyncWebServer server(80);
+
+// ===== 预渲染 =====
+#ifndef TEXT_STRIP
+#define TEXT_STRIP 1          // 1: 内容变化时把标题与正文预渲染为位图, 每帧只复制可见部分; 0: 每帧逐行绘制文字
+#endif
+#ifndef STRIP_RAM_BUDGET
+#define STRIP_RAM_BUDGET 8192 // 正文位图放在内部 RAM 的上限 (字节), 超出时放入 PSRAM, 没有 PSRAM 时放入 LittleFS
+#endif
+#ifndef OLED_HW_SCROLL
+#define OLED_HW_SCROLL TEXT_STRIP // 1: 用 SSD1306 起始行寄存器平移正文, 只发送有变化的 8x8 块 (0° 且使用预渲染时); 0: 每帧整屏发送
+#endif
+#if OLED_HW_SCROLL && !TEXT_STRIP
+#error "OLED_HW_SCROLL 需要 TEXT_STRIP"
+#endif
+
+// ===== 分阶段耗时 =====
+#ifndef STAGE_PROFILE
+#define STAGE_PROFILE 0   // 1: 统计各阶段耗时, 串口每 5 秒打印并提供 /profile 接口; 0: 完全不参与编译
+#endif
+
+// render: 排版与绘制到缓冲区  flush: sendBuffer (I2C 传输)  web: 应用网页提交的设置  time: 读取本地时间
+// jitter: 滚动一步比预定时间晚了多久  handler: /set 回调取参数与等锁的耗时 (async_tcp 任务中)
+// setlat: 请求延迟, 从 /set 收到请求到 loop() 应用完设置 (下一帧即显示新内容)
+enum ProfStage { PROF_RENDER, PROF_FLUSH, PROF_WEB, PROF_TIME, PROF_JITTER, PROF_HANDLER, PROF_SETLAT, PROF_COUNT };
+
+#if STAGE_PROFILE
+const char* profNames[PROF_COUNT] = {"render", "flush", "web", "time", "jitter", "handler", "setlat"};
+StageProfiler<PROF_COUNT> profiler;   // 单位: CPU 周期
+unsigned long lastProfilePrint = 0;
+
+#define PROF_START(t) uint32_t t = ESP.getCycleCount()
+#define PROF_LAP(stage, t)                  \
+  do {                                      \
+    uint32_t now_ = ESP.getCycleCount();    \
+    profiler.record(stage, now_ - (t));     \
+    t = now_;                               \
+  } while (0)
+#define PROF_RECORD(stage, ticks) profiler.record(stage, ticks)
+#else
+#define PROF_START(t)
+#define PROF_LAP(stage, t) \
+  do {                     \
+  } while (0)
+#define PROF_RECORD(stage, ticks) \
+  do {                            \
+  } while (0)
+#endif
+
+// ===== 调度 =====
+#ifndef FRAME_SCHEDULER
+#define FRAME_SCHEDULER 1     // 1: 按截止时间调度滚动/时钟; 0: 每帧 delay(scrollSpeed)
+#endif
 
 // ===== WiFi 信息 =====
 const char* ssid     = "MYWIFI";
@@ -75,6 +130,36 @@ int scrollSpeed = 30;   // ms
 int screenRotation = 0; // 0,1,2,3
 int wifi_status = 100;
 
+// ===== 内容行索引 =====
+// contentText 设置时拆分一次, 每帧只访问视口内的几行, 绘制时不再分配内存
+char* lineBuf = nullptr;    // contentText 的副本, 换行替换为 '\0'
+int*  lineStart = nullptr;  // 每行在 lineBuf 中的起始位置
+int   lineTotal = 0;        // 行数 (换行数 + 1)
+
+void indexContent() {
+  free(lineBuf);
+  free(lineStart);
+  int len = contentText.length();
+  lineBuf = (char*)malloc(len + 1);
+  memcpy(lineBuf, contentText.c_str(), len + 1);
+
+  lineTotal = 1;
+  for (int i = 0; i < len; i++) {
+    if (lineBuf[i] == '\n') {
+      lineTotal ++;
+    }
+  }
+  lineStart = (int*)malloc(lineTotal * sizeof(int));
+  lineStart[0] = 0;
+  int n = 1;
+  for (int i = 0; i < len; i++) {
+    if (lineBuf[i] == '\n') {
+      lineBuf[i] = 0;
+      lineStart[n++] = i + 1;
+    }
+  }
+}
+
 void connectWiFi() {
   WiFi.begin(ssid, password);
   u8g2.clearBuffer();
@@ -112,6 +197,7 @@ boolean updateTime() {
 }
 
 void applyRotation(int rot) {
+  screenRotation = rot;
   switch (rot) {
     case 1:
       u8g2.setDisplayRotation(U8G2_R1);
@@ -132,114 +218,379 @@ void applyRotation(int rot) {
   }
 }
 
-void setupWebServer() {
+#if TEXT_STRIP
+// ===== 正文位图 =====
+// 与 SSD1306 显存相同的页格式: 每页 8 行, 每列一个字节 (bit0 在上), 宽 128.
+// 每 4 行文字 (56 像素 = 7 页) 用 U8g2 画一次再整页复制, 第 i 行基线在位图第 lineHeight * (i + 1) - STRIP_DESCENT 行.
+// 只用于 0°/180° (宽 128), 90°/270° 仍逐行绘制.
+#define STRIP_LINES_PER_CHUNK 4
+#define STRIP_CHUNK_PAGES (STRIP_LINES_PER_CHUNK * lineHeight / 8)
+#define STRIP_DESCENT 3       // 基线以下留给字形下伸部分的行数
+#define STRIP_WINDOW_PAGES 9  // 每帧取出的页数 (64 行窗口跨越最多 9 页)
+static_assert(STRIP_LINES_PER_CHUNK * lineHeight % 8 == 0, "每块文字须为整页高度");
+
+enum StripStore { STRIP_NONE, STRIP_RAM, STRIP_PSRAM, STRIP_FLASH };
+StripStore stripStore = STRIP_NONE;
+uint8_t* strip = nullptr;       // STRIP_RAM / STRIP_PSRAM 时的位图
+File stripFile;                 // STRIP_FLASH 时的位图文件
+int stripPages = 0;             // 位图页数
+uint8_t stripHeader[2 * 128];   // 标题与分隔线 (显存中的两页, 不含时间)
+int stripHeaderPage = 0;        // 标题所在的第一页 (180° 时在底部)
+uint8_t stripWindow[STRIP_WINDOW_PAGES * 128]; // 本帧可见部分
+bool stripStale = true;         // 正文变化后置位, 下次 buildStrip 时重绘正文位图
+
+void freeStrip() {
+  if (stripStore == STRIP_FLASH) {
+    stripFile.close();
+  }
+  free(strip);
+  strip = nullptr;
+  stripStore = STRIP_NONE;
+}
+
+// 当前方向能否使用位图 (位图宽 128 像素, 只用于 0° / 180°)
+bool stripUsable() {
+  return stripStore != STRIP_NONE && (screenRotation == 0 || screenRotation == 2);
+}
+
+// 内容、标题或方向变化后调用. 标题每次按当前方向重绘; 正文位图只在正文变化后重绘,
+// 放在 LittleFS 时不会因为改标题或旋转屏幕而重写 /strip.bin
+void buildStrip() {
+  if (screenRotation != 0 && screenRotation != 2) {
+    return;
+  }
+
+  // 标题与分隔线: 在当前方向下绘制, 直接保存对应的两页显存
+  uint8_t* buf = u8g2.getBufferPtr();
+  u8g2.clearBuffer();
+  u8g2.setFont(u8g2_font_wqy12_t_gb2312);
+  u8g2.drawUTF8(0, 12, titleText.c_str());
+  u8g2.drawHLine(0, titleHeight, 128);
+  stripHeaderPage = screenRotation == 2 ? 6 : 0;
+  memcpy(stripHeader, buf + stripHeaderPage * 128, sizeof(stripHeader));
+  if (!stripStale && stripStore != STRIP_NONE) {
+    return;
+  }
+  freeStrip();
+
+  // 选择正文位图的存放位置
+  int chunks = (lineTotal + STRIP_LINES_PER_CHUNK - 1) / STRIP_LINES_PER_CHUNK;
+  stripPages = chunks * STRIP_CHUNK_PAGES;
+  size_t bytes = stripPages * 128;
+  if (bytes <= STRIP_RAM_BUDGET) {
+    strip = (uint8_t*)malloc(bytes);
+    stripStore = STRIP_RAM;
+  } else if (psramFound()) {
+    strip = (uint8_t*)ps_malloc(bytes);
+    stripStore = STRIP_PSRAM;
+  } else if (LittleFS.begin(false)) { // 挂载失败时不格式化 (缓存不能清掉用户数据), 退回逐行绘制
+    stripFile = LittleFS.open("/strip.bin", "w");
+    stripStore = stripFile ? STRIP_FLASH : STRIP_NONE;
+  }
+  if (stripStore != STRIP_FLASH && !strip) {
+    stripStore = STRIP_NONE;
+    return;
+  }
+
+  // 正文按块绘制 (0° 方向, 显存即位图格式)
+  u8g2.setDisplayRotation(U8G2_R0);
+  for (int c = 0; c < chunks; c++) {
+    u8g2.clearBuffer();
+    for (int k = 0; k < STRIP_LINES_PER_CHUNK; k++) {
+      int i = c * STRIP_LINES_PER_CHUNK + k;
+      if (i < lineTotal) {
+        u8g2.drawUTF8(0, lineHeight * (k + 1) - STRIP_DESCENT, lineBuf + lineStart[i]);
+      }
+    }
+    if (stripStore == STRIP_FLASH) {
+      stripFile.write(buf, STRIP_CHUNK_PAGES * 128);
+    } else {
+      memcpy(strip + c * STRIP_CHUNK_PAGES * 128, buf, STRIP_CHUNK_PAGES * 128);
+    }
+  }
+  applyRotation(screenRotation);
+
+  if (stripStore == STRIP_FLASH) {
+    stripFile.close();
+    stripFile = LittleFS.open("/strip.bin", "r");
+    if (!stripFile) {
+      stripStore = STRIP_NONE;
+      return;
+    }
+  }
+  stripStale = false;
+}
 
-  server.on("/", []() {
-  String html = R"rawliteral(
-  <!DOCTYPE html><html lang="zh-CN"><head><meta charset="UTF-8"><meta name="viewport" content="width=device-width, initial-scale=1">
-  <title>ESP32 OLED 控制台</title><link href="https://cdn.jsdelivr.net/npm/bootstrap@5.3.2/dist/css/bootstrap.min.css" rel="stylesheet"></head>
-  <body class="bg-light">
-  <div class="container mt-4">
-    <h4 class="mb-3">📟 OLED 控制面板</h4>
-    <form id="cfgForm">
-      <div class="mb-3">
-        <label class="form-label">标题</label>
-        <input class="form-control" id="title">
-      </div>
-      <div class="mb-3">
-        <label class="form-label">内容</label>
-        <textarea class="form-control" id="content" rows="4"></textarea>
-      </div>
-      <div class="mb-3">
-        <label class="form-label">方向</label>
-        <select class="form-select" id="rot">
-          <option value="0">0°</option>
-          <option value="1">90°</option>
-          <option value="2">180°</option>
-          <option value="3">270°</option>
-        </select>
-      </div>
-      <div class="mb-3">
-        <label class="form-label">滚动速度 (ms 数字越大滚动越慢)</label>
-        <input type="number" class="form-control" id="speed">
-      </div>
-      <div class="form-check mb-3">
-        <input class="form-check-input" type="checkbox" id="scrollText">
-        <label class="form-check-label">启用滚动</label>
-      </div>
-      <button type="button" class="btn btn-primary w-100" onclick="apply()">应用设置</button>
-    </form>
-    <div id="msg" class="alert alert-success d-none" style="margin-top: 1em;">设置已更新</div>
-  </div>
-  <script>
-  function loadStatus() {
-    fetch('/status')
-      .then(r => r.json())
-      .then(j => {
-        title.value = j.title;
-        content.value = j.content.trim();
-        rot.value = j.rot;
-        speed.value = j.speed;
-        scrollText.checked = j.scrollText;
-      });
-  }
-  function apply() {
-    const data = new URLSearchParams();
-    data.append("title", title.value);
-    data.append("content", content.value.trim());
-    data.append("rot", rot.value);
-    data.append("speed", speed.value);
-    if (scrollText.checked) data.append("scrollText", "1");
-    fetch("/set", { method: "POST", body: data })
-      .then(r => r.json())
-      .then(() => {
-        const msg = document.getElementById("msg");
-        msg.classList.remove("d-none");
-        setTimeout(() => msg.classList.add("d-none"), 2000);
-      });
-  }
-  window.onload = loadStatus;
-  </script></body></html>
-  )rawliteral";
-
-    server.send(200, "text/html; charset=utf-8", html);
+// 取出从第 firstPage 页开始的 STRIP_WINDOW_PAGES 页, 位图范围以外为空白
+void loadStripWindow(int firstPage) {
+  memset(stripWindow, 0, sizeof(stripWindow));
+  int from = firstPage < 0 ? 0 : firstPage;
+  int to = min(firstPage + STRIP_WINDOW_PAGES, stripPages);
+  if (from >= to) {
+    return;
+  }
+  uint8_t* dst = stripWindow + (from - firstPage) * 128;
+  if (stripStore == STRIP_FLASH) {
+    stripFile.seek(from * 128);
+    stripFile.read(dst, (to - from) * 128);
+  } else {
+    memcpy(dst, strip + from * 128, (to - from) * 128);
+  }
+}
+
+uint64_t reverseBits(uint64_t v) {
+  v = ((v >> 1) & 0x5555555555555555ULL) | ((v & 0x5555555555555555ULL) << 1);
+  v = ((v >> 2) & 0x3333333333333333ULL) | ((v & 0x3333333333333333ULL) << 2);
+  v = ((v >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((v & 0x0F0F0F0F0F0F0F0FULL) << 4);
+  return __builtin_bswap64(v);
+}
+
+// 从位图复制标题与可见的正文到显存: 屏幕第 y 行对应位图第 y - titleHeight - STRIP_DESCENT + scrollY 行
+void drawStrip() {
+  uint8_t* buf = u8g2.getBufferPtr();
+  u8g2.clearBuffer();
+  memcpy(buf + stripHeaderPage * 128, stripHeader, sizeof(stripHeader));
+  if (wifi_status > 0) {
+    // 时间
+    int tw = u8g2.getUTF8Width(timeStr);
+    u8g2.drawUTF8(128 - tw, 12, timeStr);
+  }
+
+  int offset = scrollY - titleHeight - STRIP_DESCENT; // 屏幕第 0 行对应的位图行
+  int firstPage = offset >= 0 ? offset / 8 : (offset - 7) / 8;
+  int shift = offset - firstPage * 8;
+  loadStripWindow(firstPage);
+
+  uint64_t contentMask = ~((1ULL << (titleHeight + 1)) - 1); // 分隔线以下
+  for (int x = 0; x < 128; x++) {
+    // 取出这一列的 72 行, 移位后得到屏幕上的 64 行
+    uint64_t col = 0;
+    for (int p = 0; p < 8; p++) {
+      col |= (uint64_t)stripWindow[p * 128 + x] << (p * 8);
+    }
+    uint64_t extra = stripWindow[8 * 128 + x];
+    col = shift ? (col >> shift) | (extra << (64 - shift)) : col;
+    col &= contentMask;
+    if (col == 0) {
+      continue;
+    }
+    int px = x;
+    if (screenRotation == 2) {
+      col = reverseBits(col);
+      px = 127 - x;
+    }
+    for (int p = 0; p < 8; p++) {
+      buf[p * 128 + px] |= (uint8_t)(col >> (p * 8));
+    }
+  }
+}
+#endif
+
+#if OLED_HW_SCROLL
+// ===== 起始行滚动 =====
+// 起始行为 S 时屏幕第 r 行显示显存第 (r + S) % 64 行. 让 S 跟随 scrollY, 正文在显存中不动,
+// 每步只有新露出的一行与标题 (需保持在屏幕顶部, 随 S 在显存中移动) 所在的页发生变化.
+// hwShadow 记录显存内容, 每帧按 8x8 块比较, 只发送不同的块.
+uint8_t hwShadow[8 * 128];
+bool hwShadowValid = false;
+int hwStartLine = 0;
+
+// 恢复起始行 0, 之后由 sendBuffer 整屏发送
+void stopHwScroll() {
+  if (hwStartLine != 0) {
+    u8g2.sendF("c", 0x40);
+    hwStartLine = 0;
+  }
+  hwShadowValid = false;
+}
+
+// 把 U8g2 缓冲区中的画面 (0° 方向) 按起始行 startLine 写入显存
+void sendScrolled(int startLine) {
+  uint8_t* buf = u8g2.getBufferPtr();
+  uint8_t ram[8 * 128];
+  for (int x = 0; x < 128; x++) {
+    uint64_t col = 0;
+    for (int p = 0; p < 8; p++) {
+      col |= (uint64_t)buf[p * 128 + x] << (p * 8);
+    }
+    // 屏幕第 r 行放到显存第 (r + startLine) % 64 行
+    col = startLine ? (col << startLine) | (col >> (64 - startLine)) : col;
+    for (int p = 0; p < 8; p++) {
+      ram[p * 128 + x] = (uint8_t)(col >> (p * 8));
+    }
+  }
+
+  // 逐页找出连续的变化块并发送
+  u8x8_t* u8x8 = u8g2.getU8x8();
+  for (int p = 0; p < 8; p++) {
+    int tile = 0;
+    while (tile < 16) {
+      int first = tile;
+      while (first < 16 && hwShadowValid && memcmp(ram + p * 128 + first * 8, hwShadow + p * 128 + first * 8, 8) == 0) {
+        first++;
+      }
+      int last = first;
+      while (last < 16 && (!hwShadowValid || memcmp(ram + p * 128 + last * 8, hwShadow + p * 128 + last * 8, 8) != 0)) {
+        last++;
+      }
+      if (first < last) {
+        u8x8_DrawTile(u8x8, first, p, last - first, ram + p * 128 + first * 8);
+      }
+      tile = last;
+    }
+  }
+  memcpy(hwShadow, ram, sizeof(hwShadow));
+  hwShadowValid = true;
+
+  if (startLine != hwStartLine) {
+    u8g2.sendF("c", 0x40 | startLine);
+    hwStartLine = startLine;
+  }
+}
+#endif
+
+// ===== 网页设置 =====
+// 异步服务器的回调运行在 async_tcp 任务中, 与 loop() 并发. /set 只把参数存入 pendingSet,
+// 由 loop() 在两帧之间应用 (重建行索引与位图), 绘制用的数据只在 loop() 中修改.
+// settingsLock 保护 pendingSet 以及 /status 读取的标题、内容等设置.
+struct PendingSet {
+  bool valid = false;
+  String title;
+  String content;
+  String speed;
+  String rot;
+  bool scroll = false;
+#if STAGE_PROFILE
+  // 回调与 loop() 可能在不同核心上, 各核心的周期计数不同步, 这里用 micros()
+  unsigned long receivedUs = 0; // 最早一个尚未应用的请求到达的时间
+  unsigned long handlerUs = 0;  // 最近一次回调的耗时 (不含发送响应)
+#endif
+};
+PendingSet pendingSet;
+SemaphoreHandle_t settingsLock;
+
+void applySettings() {
+  if (!pendingSet.valid) {
+    return;
+  }
+  PROF_START(t);
+  xSemaphoreTake(settingsLock, portMAX_DELAY);
+  PendingSet p = pendingSet;
+  pendingSet = PendingSet();
+
+  if (p.title.length() > 0) {
+    titleText = p.title;
+  }
+
+  enableScroll = p.scroll;
+
+  if (p.content.length() > 0) {
+    contentText = (enableScroll ? "\n\n\n" : "") + p.content;
+  }
+
+  if (p.speed.length() > 0) {
+    scrollSpeed = max(1, (int)p.speed.toInt());
+  }
+  xSemaphoreGive(settingsLock);
+
+  if (p.content.length() > 0) {
+    indexContent();
+#if TEXT_STRIP
+    stripStale = true;
+#endif
+  }
+  scrollY = 0;
+
+  if (p.rot.length() > 0) {
+    applyRotation(p.rot.toInt());
+  }
+#if TEXT_STRIP
+  buildStrip();
+#endif
+  PROF_LAP(PROF_WEB, t);
+  // 统计只在 loop() 中记录, 不与绘制并发
+  PROF_RECORD(PROF_HANDLER, p.handlerUs * ESP.getCpuFreqMHz());
+  PROF_RECORD(PROF_SETLAT, (micros() - p.receivedUs) * ESP.getCpuFreqMHz());
+}
+
+void setupWebServer() {
+  settingsLock = xSemaphoreCreateMutex();
+
+  // 控制页: 编译时压缩好的 PROGMEM 数据直接从 flash 发送, 不在堆上拼接 HTML.
+  // ETag 为压缩数据的哈希, 浏览器缓存未过期时只回 304
+  server.on("/", HTTP_GET, [](AsyncWebServerRequest* request) {
+    if (request->hasHeader("If-None-Match") && request->header("If-None-Match") == INDEX_HTML_ETAG) {
+      AsyncWebServerResponse* response = request->beginResponse(304);
+      response->addHeader("ETag", INDEX_HTML_ETAG);
+      request->send(response);
+      return;
+    }
+    AsyncWebServerResponse* response =
+      request->beginResponse(200, "text/html; charset=utf-8", INDEX_HTML_GZ, INDEX_HTML_GZ_LEN);
+    response->addHeader("Content-Encoding", "gzip");
+    response->addHeader("ETag", INDEX_HTML_ETAG);
+    response->addHeader("Cache-Control", "no-cache");   // 每次向板子确认, 固件更新后立即生效
+    request->send(response);
   });
 
-  server.on("/status", []() {
+  server.on("/status", HTTP_GET, [](AsyncWebServerRequest* request) {
     JsonDocument doc;
+    xSemaphoreTake(settingsLock, portMAX_DELAY);
     doc["title"]   = titleText;
     doc["content"] = contentText;
     doc["scrollText"]  = enableScroll;
     doc["speed"]   = scrollSpeed;
+    xSemaphoreGive(settingsLock);
     doc["rot"]     = screenRotation;
 
     String out;
     serializeJson(doc, out);
-    server.send(200, "application/json", out);
+    request->send(200, "application/json", out);
   });
 
-  server.on("/set", []() {
-
-    if (server.hasArg("title") && server.arg("title").length() > 0) {
-      titleText = server.arg("title");
-    }
-
-    enableScroll = server.hasArg("scrollText");
-
-    if (server.hasArg("content") && server.arg("content").length() > 0) {
-      contentText = (enableScroll ? "\n\n\n" : "") + server.arg("content");
+#if STAGE_PROFILE
+  // 各阶段本统计周期的耗时 (us)
+  server.on("/profile", HTTP_GET, [](AsyncWebServerRequest* request) {
+    float mhz = ESP.getCpuFreqMHz();
+    JsonDocument doc;
+    doc["unit"]   = "us";
+    doc["cpuMHz"] = ESP.getCpuFreqMHz();
+    for (int i = 0; i < PROF_COUNT; i++) {
+      StageSummary s = profiler.summary(i);
+      JsonObject st = doc[profNames[i]].to<JsonObject>();
+      st["n"]   = s.count;
+      st["min"] = s.min / mhz;
+      st["avg"] = s.avg / mhz;
+      st["p99"] = s.p99 / mhz;
+      st["max"] = s.max / mhz;
     }
 
-    if (server.hasArg("speed") && server.arg("speed").length() > 0) {
-      scrollSpeed = server.arg("speed").toInt();
-    }
-    scrollY = 0;
+    String out;
+    serializeJson(doc, out);
+    request->send(200, "application/json", out);
+  });
+#endif
 
-    if (server.hasArg("rot") && server.arg("rot").length() > 0) {
-      applyRotation(server.arg("rot").toInt());
+  server.on("/set", HTTP_ANY, [](AsyncWebServerRequest* request) {
+#if STAGE_PROFILE
+    unsigned long start = micros();
+#endif
+    xSemaphoreTake(settingsLock, portMAX_DELAY);
+    pendingSet.title   = request->hasArg("title") ? request->arg("title") : String();
+    pendingSet.content = request->hasArg("content") ? request->arg("content") : String();
+    pendingSet.speed   = request->hasArg("speed") ? request->arg("speed") : String();
+    pendingSet.rot     = request->hasArg("rot") ? request->arg("rot") : String();
+    pendingSet.scroll  = request->hasArg("scrollText");
+#if STAGE_PROFILE
+    if (!pendingSet.valid) {
+      pendingSet.receivedUs = start;
     }
+    pendingSet.handlerUs = micros() - start;
+#endif
+    pendingSet.valid   = true;
+    xSemaphoreGive(settingsLock);
 
-    server.send(200, "application/json", "{\"ok\":true}");
+    request->send(200, "application/json", "{\"ok\":true}");
   });
 
   server.begin();
@@ -247,6 +598,10 @@ void setupWebServer() {
 
 void setup() {
 
+#if STAGE_PROFILE
+  Serial.begin(115200);
+#endif
+
 #ifdef OLED_GND
   pinMode(OLED_GND, OUTPUT);
   digitalWrite(OLED_GND, LOW);
@@ -257,6 +612,8 @@ void setup() {
   digitalWrite(OLED_VDD, HIGH);
 #endif
 
+  indexContent();
+
   Wire.begin(OLED_SDA, OLED_SCK);
   u8g2.begin();
   u8g2.enableUTF8Print();
@@ -272,10 +629,14 @@ void setup() {
     delay(500);
     updateTime();
   }
+#if TEXT_STRIP
+  buildStrip();
+#endif
   setupWebServer();
 }
 
-void drawContent() {
+// 逐行绘制标题、时间与可见的正文
+void drawLines() {
   u8g2.clearBuffer();
   u8g2.setFont(u8g2_font_wqy12_t_gb2312);
 
@@ -290,29 +651,41 @@ void drawContent() {
 
   u8g2.drawHLine(0, titleHeight, 128);
 
-  // 内容绘制
-  int y = titleHeight + lineHeight - scrollY;
-  int start = 0;
-  int lineCount = 0;
-  while (true) {
-    int end = contentText.indexOf('\n', start);
-    if (end == -1) {
-      end = contentText.length();
-    }
-
-    String line = contentText.substring(start, end);
-    if (y >= titleHeight + lineHeight - 2 && y < screenHeight + lineHeight) {
-      u8g2.drawUTF8(0, y, line.c_str());
-    }
+  // 内容绘制: 第 i 行基线为 titleHeight + lineHeight - scrollY + i * lineHeight,
+  // 从第一行基线不低于 titleHeight + lineHeight - 2 的行画到超出屏幕为止
+  int first = scrollY > 2 ? (scrollY - 2 + lineHeight - 1) / lineHeight : 0;
+  int y = titleHeight + lineHeight - scrollY + first * lineHeight;
+  for (int i = first; i < lineTotal && y < screenHeight + lineHeight; i++) {
+    u8g2.drawUTF8(0, y, lineBuf + lineStart[i]);
     y += lineHeight;
-    if (end >= contentText.length()) {
-      break;
-    }
-    lineCount ++;
-    start = end + 1;
   }
+}
+
+void drawContent() {
+  PROF_START(t);
+#if TEXT_STRIP
+  if (stripUsable()) {
+    drawStrip();
+  } else {
+    drawLines();
+  }
+#else
+  drawLines();
+#endif
+  int lineCount = lineTotal - 1;
 
+  PROF_LAP(PROF_RENDER, t);
+#if OLED_HW_SCROLL
+  if (stripUsable() && screenRotation == 0) {
+    sendScrolled(scrollY & 63);
+  } else {
+    stopHwScroll();
+    u8g2.sendBuffer();
+  }
+#else
   u8g2.sendBuffer();
+#endif
+  PROF_LAP(PROF_FLUSH, t);
 
   if (enableScroll) {
     scrollY++;
@@ -320,17 +693,110 @@ void drawContent() {
       scrollY = 0;
     }
   }
+}
 
-  delay(scrollSpeed);
+void refreshTime() {
+  PROF_START(t);
+  updateTime();
+  PROF_LAP(PROF_TIME, t);
+}
+
+#if STAGE_PROFILE
+// 串口打印各阶段统计并开始新的统计周期
+void printProfile() {
+  float mhz = ESP.getCpuFreqMHz();
+  for (int i = 0; i < PROF_COUNT; i++) {
+    StageSummary s = profiler.summary(i);
+    Serial.printf("  %-7s n %4u  min %8.1f  avg %8.1f  p99 %8.1f  max %8.1f us\n", profNames[i], s.count,
+                  s.min / mhz, s.avg / mhz, s.p99 / mhz, s.max / mhz);
+  }
+  profiler.request_reset();
 }
+#endif
+
+#if FRAME_SCHEDULER
+// 协作式调度: 每个任务有自己的周期与下次截止时间 (us), 到期即运行, 截止时间按周期累加,
+// 渲染耗时不会让滚动节奏漂移; 落后超过一个周期时从当前时间重新开始.
+// 网页请求由 async_tcp 任务并发处理, 提交的设置在任务之间应用.
+struct Task {
+  unsigned long periodUs;
+  unsigned long due;
+  void (*run)();
+  bool needsWifi;
+};
+
+enum TaskId { TASK_SCROLL, TASK_CLOCK, TASK_PROFILE, TASK_COUNT };
+Task tasks[TASK_COUNT] = {
+  {30000, 0, drawContent, false},
+  {1000000, 0, refreshTime, true},
+#if STAGE_PROFILE
+  {5000000, 0, printProfile, false},
+#else
+  {0, 0, nullptr, false},
+#endif
+};
+
+void loop() {
+  static bool started = false;
+  if (!started) {
+    for (int i = 0; i < TASK_COUNT; i++) {
+      tasks[i].due = micros();
+    }
+    started = true;
+  }
+  tasks[TASK_SCROLL].periodUs = scrollSpeed * 1000UL;
+  for (int i = 0; i < TASK_COUNT; i++) {
+    Task& task = tasks[i];
+    if (!task.run || (task.needsWifi && wifi_status == 0)) {
+      continue;
+    }
+    unsigned long now = micros();
+    long late = (long)(now - task.due);
+    if (late < 0) {
+      continue;
+    }
+    if (i == TASK_SCROLL) {
+      PROF_RECORD(PROF_JITTER, (uint32_t)late * ESP.getCpuFreqMHz());
+    }
+    task.run();
+    task.due += task.periodUs;
+    if ((long)(micros() - task.due) > (long)task.periodUs) {
+      task.due = micros() + task.periodUs;
+    }
+  }
 
+  applySettings();
+  // 离最近的截止时间还早时让出 CPU
+  long idle = (long)(tasks[TASK_SCROLL].due - micros());
+  if (idle > 2000) {
+    delay(1);
+  }
+}
+#else
 void loop() {
 
+  applySettings();
+
   if (wifi_status > 0 && millis() - lastTimeUpdate >= 1000) {
-    server.handleClient();
-    updateTime();
+    refreshTime();
     lastTimeUpdate = millis();
   }
 
+#if STAGE_PROFILE
+  if (millis() - lastProfilePrint >= 5000) {
+    printProfile();
+    lastProfilePrint = millis();
+  }
+#endif
+
+  // 滚动晚于上一步 + scrollSpeed 的部分即为渲染与发送造成的漂移
+  static unsigned long lastStep = 0;
+  unsigned long now = micros();
+  if (lastStep != 0) {
+    PROF_RECORD(PROF_JITTER, (uint32_t)(now - lastStep - scrollSpeed * 1000UL) * ESP.getCpuFreqMHz());
+  }
+  lastStep = now;
   drawContent();
-}
\ No newline at end of file
+  delay(scrollSpeed);
+}
+#endif
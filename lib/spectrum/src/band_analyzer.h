@@ -0,0 +1,146 @@
+#pragma once
+#include "fast_db.h"
+#include "peak_interp.h"
+#include "spectrum_config.h"
+#include <math.h>
+#include <stdint.h>
+
+/*
+ * 频段计算 (FFT 幅值 -> 显示用频段值)
+ *
+ * 按 Config::binEdges 取每个频段内的最大幅值, 扣除噪声底并放大到 0~100,
+ * 再做上升/下降两种系数的平滑与峰值线下落. 顶部显示的最大分贝与频率
+ * 每 peakIntervalMs 毫秒才更新一次, 频率按 interp 在峰值 bin 附近插值.
+ * BandParams 中的平滑系数与峰值下落速度按 "每 Config::samples 个采样一帧" 给出;
+ * 重叠分帧或滑动 DFT 每 hop 个采样出一帧时, 构造时换算成每帧的值,
+ * 使上升/下降与下落的速度按实际时间计保持不变.
+ * 不依赖 Arduino, 可在主机 (PlatformIO native) 上编译运行.
+ */
+
+struct BandParams {
+  float noiseFloor; // 噪声抑制 越大抑制程度越高
+  float dbMult;     // 放大倍数 越大越灵敏
+  float peakFall;   // 峰值线下落速度 越大下落越快
+  float smoothUp;   // 上升平滑系数 0~1 越大上升响应越快
+  float smoothDown; // 下降平滑系数 0~1 越大下降响应越快
+};
+
+// 一帧待显示的频谱数据
+template <typename T, int Bands>
+struct SpectrumFrame {
+  T bandDb[Bands]; // 当前显示的频谱数据 (0~100)
+  T peakDb[Bands]; // 频谱顶点数据 (0~100)
+  T maxDb;         // 顶部显示的分贝值
+  T maxFreq;       // 顶部显示的频率值
+  T currentDb;     // 当前帧最大分贝 (闲置/唤醒判定)
+};
+
+// Config 为 SpectrumConfig<...>
+template <typename T, class Config>
+class BandAnalyzer {
+public:
+  static const int Bands = Config::bands;
+  typedef SpectrumFrame<T, Bands> Frame;
+
+  // hop: 相邻两帧之间的新采样数; interp: 峰值频率插值方式
+  explicit BandAnalyzer(const BandParams &params, uint16_t peakIntervalMs = 500, uint16_t hop = Config::samples,
+                        PeakInterp interp = PEAK_LOG_PARABOLIC)
+      : params_(rescale(params, hop)), scale_((T)params.dbMult * 100 / 2048), peakInterval_(peakIntervalMs),
+        interp_(interp) {
+    reset();
+  }
+
+  // 每帧时长缩短为 k = hop / samples 倍: 指数平滑 1 - (1 - a)^k, 峰值下落 * k
+  static BandParams rescale(const BandParams &p, uint16_t hop) {
+    if (hop == Config::samples) {
+      return p;
+    }
+    double k = (double)hop / Config::samples;
+    BandParams r = p;
+    r.peakFall = p.peakFall * k;
+    r.smoothUp = 1 - pow(1 - p.smoothUp, k);
+    r.smoothDown = 1 - pow(1 - p.smoothDown, k);
+    return r;
+  }
+
+  void reset() {
+    for (int i = 0; i < Bands; i++) {
+      bandDb_[i] = 0;
+      peakDb_[i] = 0;
+    }
+    maxDb_ = 0;
+    maxFreq_ = 0;
+    lastPeakUpdate_ = 0;
+  }
+
+  // mag[0..Config::bins) 为 FFT 幅值, nowMs 为当前时间 (毫秒)
+  void process(const T *mag, uint32_t nowMs, Frame &f) {
+    // 1. 查找当前帧最大值及其对应频率 (跳过低于未补零时 bin 4 的低频)
+    T frameMax = 0;
+    int frameBin = 0;
+    for (int i = 4 * Config::zeroPad; i < Config::bins; i++) {
+      if (mag[i] > frameMax) {
+        frameMax = mag[i];
+        frameBin = i;
+      }
+    }
+
+    // 2. 各频段取最大幅值
+    T bandAmp[Bands];
+    for (int i = 0; i < Bands; i++) {
+      T maxAmp = 0;
+      for (int j = Config::binEdges[i]; j < Config::binEdges[i + 1]; j++) {
+        if (mag[j] > maxAmp) {
+          maxAmp = mag[j];
+        }
+      }
+      bandAmp[i] = maxAmp;
+    }
+    T peakBin = frameBin + peak_offset(mag, frameBin, Config::bins, interp_);
+    update(bandAmp, frameMax, peakBin * Config::hzPerBin, nowMs, f);
+  }
+
+  // bandAmp 为已按频段取好的幅值 (如 SlidingDftBank 的输出),
+  // frameMax / peakFreq 为本帧最大幅值及其频率
+  void update(const T *bandAmp, T frameMax, T peakFreq, uint32_t nowMs, Frame &f) {
+    f.currentDb = fast_db(frameMax);
+
+    if (nowMs - lastPeakUpdate_ > peakInterval_) {
+      maxDb_ = f.currentDb;
+      maxFreq_ = peakFreq;
+      lastPeakUpdate_ = nowMs;
+    }
+    f.maxDb = maxDb_;
+    f.maxFreq = maxFreq_;
+
+    // 归一化后平滑, 峰值线下落
+    const BandParams &p = params_;
+    for (int i = 0; i < Bands; i++) {
+      // (maxAmp - noiseFloor) / 2048 * dbMult 截到 0~1 再乘 100, 合并为一次乘法
+      T db = (bandAmp[i] - p.noiseFloor) * scale_;
+      db = db < 0 ? 0 : (db > 100 ? 100 : db);
+      T smooth = db > bandDb_[i] ? p.smoothUp : p.smoothDown;
+      bandDb_[i] = db * smooth + bandDb_[i] * (1 - smooth);
+
+      if (bandDb_[i] > peakDb_[i]) {
+        peakDb_[i] = bandDb_[i];
+      } else {
+        peakDb_[i] -= p.peakFall;
+      }
+
+      f.bandDb[i] = bandDb_[i];
+      f.peakDb[i] = peakDb_[i];
+    }
+  }
+
+private:
+  BandParams params_;
+  T scale_; // dbMult * 100 / 2048
+  uint16_t peakInterval_;
+  PeakInterp interp_;
+  T bandDb_[Bands];
+  T peakDb_[Bands];
+  T maxDb_;
+  T maxFreq_;
+  uint32_t lastPeakUpdate_;
+};
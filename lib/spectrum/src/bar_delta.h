@@ -0,0 +1,93 @@
+#pragma once
+#include <stdint.h>
+
+/*
+ * 频谱条增量绘制
+ *
+ * 记录每个频段上次绘制的方块数与峰值线位置, 每帧只补画新增的方块、
+ * 擦除消失的方块, 峰值线移动或被覆盖时才重画, 不再整列清空重绘.
+ *
+ * Canvas 需提供:
+ *   void fill(int x, int y, int w, int h, uint16_t color);
+ *   uint16_t block_color(int b); // 第 b 个方块 (自下而上) 的颜色
+ *   uint16_t background();
+ *   uint16_t peak_color();
+ */
+struct BarLayout {
+  int16_t barWidth;  // 频段横向间距
+  int16_t blockW;    // 方块 / 峰值线宽度
+  int16_t blockH;    // 方块纵向间距
+  int16_t blockFill; // 方块实心高度
+  int16_t bottom;    // 频谱区底边 (不含)
+};
+
+template <int Bands>
+class BarDelta {
+public:
+  explicit BarDelta(const BarLayout &layout) : layout_(layout) {
+    reset();
+  }
+
+  // 屏幕被其它内容清空后调用, 下一帧完整重绘
+  void reset() {
+    for (int i = 0; i < Bands; i++) {
+      blocks_[i] = 0;
+      peakY_[i] = -1;
+    }
+  }
+
+  template <class Canvas>
+  void draw(Canvas &c, int band, int numBlocks, int peakY) {
+    const BarLayout &l = layout_;
+    int x = band * l.barWidth;
+    int old = blocks_[band];
+    int oldY = peakY_[band];
+
+    if (numBlocks < old) {
+      // 擦除消失的方块 (连同其间的空隙一次填充)
+      int top = block_top(old - 1);
+      int bot = block_top(numBlocks) + l.blockFill;
+      c.fill(x, top, l.blockW, bot - top, c.background());
+    }
+    for (int b = old; b < numBlocks; b++) {
+      // 补画新增的方块
+      c.fill(x, block_top(b), l.blockW, l.blockFill, c.block_color(b));
+    }
+    blocks_[band] = numBlocks;
+
+    if (peakY != oldY) {
+      // 恢复旧峰值线下方的内容 (本帧已重画的行除外)
+      if (oldY >= 0 && !repainted(oldY, old, numBlocks)) {
+        int b = block_at(oldY);
+        c.fill(x, oldY, l.blockW, 1, b >= 0 && b < numBlocks ? c.block_color(b) : c.background());
+      }
+      c.fill(x, peakY, l.blockW, 1, c.peak_color());
+      peakY_[band] = peakY;
+    } else if (repainted(peakY, old, numBlocks)) {
+      // 峰值线被本帧的方块改动覆盖, 重画
+      c.fill(x, peakY, l.blockW, 1, c.peak_color());
+    }
+  }
+
+private:
+  int block_top(int b) const {
+    return layout_.bottom - (b + 1) * layout_.blockH;
+  }
+  // y 所在方块的序号, 落在空隙里返回 -1
+  int block_at(int y) const {
+    int b = (layout_.bottom - 1 - y) / layout_.blockH;
+    return y - block_top(b) < layout_.blockFill ? b : -1;
+  }
+  // 方块数从 old 变为 now 时, 第 y 行是否被重画过
+  bool repainted(int y, int old, int now) const {
+    if (now < old) {
+      return y >= block_top(old - 1) && y < block_top(now) + layout_.blockFill;
+    }
+    int b = block_at(y);
+    return b >= old && b < now;
+  }
+
+  BarLayout layout_;
+  int8_t blocks_[Bands];
+  int16_t peakY_[Bands];
+};
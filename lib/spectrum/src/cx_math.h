@@ -0,0 +1,159 @@
+#pragma once
+#include <stdint.h>
+
+/*
+ * 编译期 (constexpr) 数学函数与查找表
+ *
+ * 窗函数、旋转因子、频段边界表都由这里在编译期生成, 直接作为常量放进 flash,
+ * 启动时不再循环调用 cos/sin, 也不占用 RAM. 需要 C++17 (-std=gnu++17).
+ */
+namespace cx {
+
+constexpr double PI = 3.14159265358979323846;
+
+// 定长查找表 (constexpr 函数可以逐项赋值后整体返回)
+template <typename T, int Len>
+struct Table {
+  T v[Len];
+  constexpr const T &operator[](int i) const {
+    return v[i];
+  }
+  constexpr const T *data() const {
+    return v;
+  }
+};
+
+// 先把角度归约到 [-pi, pi], 再用泰勒级数, 误差小于 1e-15
+constexpr double sin(double x) {
+  while (x > PI) {
+    x -= 2 * PI;
+  }
+  while (x < -PI) {
+    x += 2 * PI;
+  }
+  double term = x;
+  double sum = x;
+  for (int n = 1; n < 16; n++) {
+    term *= -x * x / ((2 * n) * (2 * n + 1));
+    sum += term;
+  }
+  return sum;
+}
+
+constexpr double cos(double x) {
+  return sin(x + PI / 2);
+}
+
+constexpr double ipow(double x, int n) {
+  double r = 1;
+  for (int i = 0; i < n; i++) {
+    r *= x;
+  }
+  return r;
+}
+
+// a 的 n 次方根 (a >= 1), 二分查找
+constexpr double root(double a, int n) {
+  double lo = 1;
+  double hi = a;
+  for (int i = 0; i < 64; i++) {
+    double mid = (lo + hi) / 2;
+    if (ipow(mid, n) > a) {
+      hi = mid;
+    } else {
+      lo = mid;
+    }
+  }
+  return lo;
+}
+
+// 自然对数 (x > 0): 先提出 2 的整数次幂, 再用 ln(y) = 2 atanh((y-1)/(y+1))
+constexpr double ln(double x) {
+  const double LN2 = 0.69314718055994530942;
+  int e = 0;
+  while (x >= 2) {
+    x /= 2;
+    e++;
+  }
+  while (x < 1) {
+    x *= 2;
+    e--;
+  }
+  double z = (x - 1) / (x + 1);
+  double z2 = z * z;
+  double term = z;
+  double sum = 0;
+  for (int n = 1; n < 40; n += 2) {
+    sum += term / n;
+    term *= z2;
+  }
+  return 2 * sum + e * LN2;
+}
+
+// 四舍五入 (远离 0), 与 lround 相同
+constexpr long round(double v) {
+  return v >= 0 ? (long)(v + 0.5) : -(long)(-v + 0.5);
+}
+
+constexpr int16_t to_q15(double v) {
+  long q = round(v * 32768.0);
+  return (int16_t)(q > 32767 ? 32767 : (q < -32768 ? -32768 : q));
+}
+
+// Hamming 窗 (与 arduinoFFT 相同的对称定义)
+template <typename T, int N>
+constexpr Table<T, N> hamming() {
+  Table<T, N> t{};
+  for (int i = 0; i < N; i++) {
+    t.v[i] = 0.54 - 0.46 * cos(2 * PI * i / (N - 1));
+  }
+  return t;
+}
+
+template <int N>
+constexpr Table<int16_t, N> hamming_q15() {
+  Table<int16_t, N> t{};
+  for (int i = 0; i < N; i++) {
+    t.v[i] = to_q15(0.54 - 0.46 * cos(2 * PI * i / (N - 1)));
+  }
+  return t;
+}
+
+// 旋转因子 W_N^k = cos(2pi k/N) - j sin(2pi k/N), k = 0..N/2-1
+template <typename T, int N>
+constexpr Table<T, N / 2> twiddle_cos() {
+  Table<T, N / 2> t{};
+  for (int k = 0; k < N / 2; k++) {
+    t.v[k] = cos(2 * PI * k / N);
+  }
+  return t;
+}
+
+template <typename T, int N>
+constexpr Table<T, N / 2> twiddle_sin() {
+  Table<T, N / 2> t{};
+  for (int k = 0; k < N / 2; k++) {
+    t.v[k] = sin(2 * PI * k / N);
+  }
+  return t;
+}
+
+template <int N>
+constexpr Table<int16_t, N / 2> twiddle_cos_q15() {
+  Table<int16_t, N / 2> t{};
+  for (int k = 0; k < N / 2; k++) {
+    t.v[k] = to_q15(cos(2 * PI * k / N));
+  }
+  return t;
+}
+
+template <int N>
+constexpr Table<int16_t, N / 2> twiddle_sin_q15() {
+  Table<int16_t, N / 2> t{};
+  for (int k = 0; k < N / 2; k++) {
+    t.v[k] = to_q15(sin(2 * PI * k / N));
+  }
+  return t;
+}
+
+} // namespace cx
@@ -0,0 +1,74 @@
+#pragma once
+#include "cx_math.h"
+#include <stdint.h>
+
+/*
+ * 每帧热点路径上的查表运算
+ *
+ * fast_db: 幅值 -> 分贝, 代替 20 * log10(x + 1).
+ *   整数 log2 (前导零计数) 取整数部分, 小数部分查 33 项表并线性插值.
+ *   x 先放大 256 倍取整, 误差不超过 0.015 dB (x >= 1 时不超过 0.009 dB),
+ *   在 ESP32-C3 / RP2040 这类没有 FPU 的核上省掉一次软浮点 log10.
+ * LevelMap: 0~100 的频段值 -> 像素 (或方块数), 编译期生成 101 项表,
+ *   结果与 Arduino map((long)v, 0, 100, OutMin, OutMax) / Div 完全相同.
+ */
+
+namespace fastdb {
+
+// log2(1 + i/32), Q16
+constexpr cx::Table<uint32_t, 33> make_log2_table() {
+  cx::Table<uint32_t, 33> t{};
+  for (int i = 0; i <= 32; i++) {
+    t.v[i] = (uint32_t)cx::round(cx::ln(1 + i / 32.0) / cx::ln(2.0) * 65536);
+  }
+  return t;
+}
+
+constexpr cx::Table<uint32_t, 33> LOG2_TABLE = make_log2_table();
+
+// log2(v), Q16, v > 0
+inline uint32_t log2_q16(uint32_t v) {
+  int n = 31 - __builtin_clz(v);
+  uint32_t m = v << (31 - n); // 最高位对齐到 bit31
+  uint32_t idx = (m >> 26) & 31;
+  uint32_t frac = (m >> 10) & 0xFFFF;
+  uint32_t lo = LOG2_TABLE[idx];
+  uint32_t hi = LOG2_TABLE[idx + 1];
+  return ((uint32_t)n << 16) + lo + (((hi - lo) * frac) >> 16);
+}
+
+} // namespace fastdb
+
+// 20 * log10(x + 1), x >= 0
+template <typename T>
+inline T fast_db(T x) {
+  const T DB_PER_Q16 = 6.02059991327962 / 65536; // 20 * log10(2) / 2^16
+  T scaled = (x + 1) * 256;
+  uint32_t v = scaled < 4294967040.0 ? (uint32_t)(scaled + (T)0.5) : 0xFFFFFF00u;
+  return (T)((int32_t)(fastdb::log2_q16(v) - (8u << 16))) * DB_PER_Q16;
+}
+
+namespace fastdb {
+
+template <int OutMin, int OutMax, int Div>
+constexpr cx::Table<int16_t, 101> make_level_table() {
+  cx::Table<int16_t, 101> t{};
+  for (long i = 0; i <= 100; i++) {
+    t.v[i] = (i * (OutMax - OutMin) / 100 + OutMin) / Div;
+  }
+  return t;
+}
+
+} // namespace fastdb
+
+// 0~100 -> [OutMin, OutMax] 的整数映射表, 超出 0~100 的输入先截到两端
+template <int OutMin, int OutMax, int Div = 1>
+struct LevelMap {
+  static constexpr cx::Table<int16_t, 101> table = fastdb::make_level_table<OutMin, OutMax, Div>();
+
+  template <typename T>
+  static int at(T v) {
+    int i = (int)v;
+    return table[i < 0 ? 0 : (i > 100 ? 100 : i)];
+  }
+};
@@ -0,0 +1,147 @@
+#pragma once
+#include "cx_math.h"
+#include <stdint.h>
+
+/*
+ * Q15 定点实数输入 FFT, 供没有 FPU 的 RP2040 (Cortex-M0+) / ESP32-C3 (RV32IMC) 使用
+ *
+ * 输入: 以 0 为中心的 12 位 ADC 采样 (-2048..2047), 内部左移 4 位占满 Q15
+ * 输出: N/2 个整数幅值, 与浮点 arduinoFFT 的
+ *       Windowing(Hamming) + Compute + ComplexToMagnitude 结果同一单位
+ *
+ * 与 RealFft 相同, 实数采样按偶/奇交错做 N/2 点复数 FFT 再拆分, 不需要虚部数组.
+ * 溢出控制采用块浮点: 只有当前数据可能溢出时该级才右移 1 位,
+ * 小信号几乎不损失精度, 大信号最多每级右移一次.
+ * 误差: 幅值采用 alpha*max + beta*min 近似, 最大相对误差约 4%;
+ *       换算成 0~100 的频段高度后, 与浮点路径相差不超过 10 (约一个方块),
+ *       超过 3 的情况只出现在接近满幅正弦的旁瓣频段.
+ * W < N 时只对前 W 个采样加窗, 其余补零 (同 RealFft).
+ */
+template <uint16_t N, uint16_t W = N>
+class FftQ15 {
+public:
+  static_assert(N >= 8 && (N & (N - 1)) == 0, "N 必须为 2 的幂");
+  static_assert(W >= 2 && W <= N, "窗长不能超过 N");
+  static const uint16_t M = N / 2; // 复数 FFT 点数
+
+  // 实数采样 -> 幅值: x 为输入 (只需填好前 W 个, 会被改写为打包频谱), mag 输出 N/2 个幅值
+  void analyze(int16_t *x, uint32_t *mag) const {
+    int32_t peak = window(x);
+    int shifts = compute(x, peak);
+    magnitude(x, mag, shifts);
+  }
+
+  // 左移 4 位并乘以窗函数 (前 W 个), 其余补零; 返回各值绝对值按位或, 供 compute 判断溢出
+  int32_t window(int16_t *x) const {
+    int32_t peak = 0;
+    for (int i = 0; i < W; i++) {
+      int32_t v = ((int32_t)x[i] * 16 * window_[i]) >> 15;
+      x[i] = (int16_t)v;
+      peak |= v < 0 ? -v : v;
+    }
+    for (int i = W; i < N; i++) {
+      x[i] = 0;
+    }
+    return peak;
+  }
+
+  // 原地实数 FFT, peak 为输入各值绝对值的上界 (按位或即可)
+  // 输出打包格式同 RealFft::compute, 结果为 X[k] / 2^返回值
+  int compute(int16_t *x, int32_t peak) const {
+    // 1. N/2 点复数 FFT (偶数样本为实部, 奇数样本为虚部)
+    for (int i = 1, j = 0; i < M; i++) {
+      int bit = M >> 1;
+      for (; j & bit; bit >>= 1) {
+        j ^= bit;
+      }
+      j |= bit;
+      if (i < j) {
+        int16_t t = x[2 * i];
+        x[2 * i] = x[2 * j];
+        x[2 * j] = t;
+        t = x[2 * i + 1];
+        x[2 * i + 1] = x[2 * j + 1];
+        x[2 * j + 1] = t;
+      }
+    }
+    // 蝶形运算: 分量均小于 8192 时模长小于 16384, 不缩放也不会溢出
+    int shifts = 0;
+    for (int len = 2; len <= M; len <<= 1) {
+      int sh = peak >= 0x2000 ? 1 : 0;
+      int32_t rnd = sh;
+      int half = len >> 1;
+      int step = N / len; // W_M^k = W_N^(2k)
+      shifts += sh;
+      peak = 0;
+      for (int i = 0; i < M; i += len) {
+        for (int k = 0; k < half; k++) {
+          int32_t c = cos_[k * step];
+          int32_t s = sin_[k * step];
+          int16_t *a = x + 2 * (i + k);
+          int16_t *b = x + 2 * (i + k + half);
+          // t = b * (cos - j*sin)
+          int32_t tr = (b[0] * c + b[1] * s + 0x4000) >> 15;
+          int32_t ti = (b[1] * c - b[0] * s + 0x4000) >> 15;
+          int32_t v0 = (a[0] + tr + rnd) >> sh;
+          int32_t v1 = (a[1] + ti + rnd) >> sh;
+          int32_t v2 = (a[0] - tr + rnd) >> sh;
+          int32_t v3 = (a[1] - ti + rnd) >> sh;
+          a[0] = (int16_t)v0;
+          a[1] = (int16_t)v1;
+          b[0] = (int16_t)v2;
+          b[1] = (int16_t)v3;
+          peak |= (v0 < 0 ? -v0 : v0) | (v1 < 0 ? -v1 : v1) | (v2 < 0 ? -v2 : v2) | (v3 < 0 ? -v3 : v3);
+        }
+      }
+    }
+
+    // 2. 拆分: X[k] = E + W^k * O, X[M-k] = conj(E - W^k * O), 结果模长最多为输入的 2 倍
+    int sh = peak >= 0x2000 ? 1 : 0;
+    shifts += sh;
+    int32_t z0 = x[0];
+    x[0] = (int16_t)((z0 + x[1]) >> sh);
+    x[1] = (int16_t)((z0 - x[1]) >> sh);
+    sh += 1; // E / O 自带的 1/2
+    int32_t rnd = 1 << (sh - 1);
+    for (int k = 1; k <= M / 2; k++) {
+      int16_t *p = x + 2 * k;
+      int16_t *q = x + 2 * (M - k);
+      int32_t er = p[0] + q[0];
+      int32_t ei = p[1] - q[1];
+      int32_t or_ = p[1] + q[1];
+      int32_t oi = q[0] - p[0];
+      int32_t c = cos_[k];
+      int32_t s = sin_[k];
+      int32_t wr = (or_ * c + oi * s + 0x4000) >> 15;
+      int32_t wi = (oi * c - or_ * s + 0x4000) >> 15;
+      p[0] = (int16_t)((er + wr + rnd) >> sh);
+      p[1] = (int16_t)((ei + wi + rnd) >> sh);
+      q[0] = (int16_t)((er - wr + rnd) >> sh); // k = M/2 时 p 与 q 相同, 结果为 conj(Z[M/2])
+      q[1] = (int16_t)((wi - ei + rnd) >> sh);
+    }
+    return shifts;
+  }
+
+  // 整数幅值近似: |z| ~= 0.961 * max + 0.398 * min
+  static uint32_t approx_mag(int32_t r, int32_t i) {
+    uint32_t a = r < 0 ? -r : r;
+    uint32_t b = i < 0 ? -i : i;
+    uint32_t hi = a > b ? a : b;
+    uint32_t lo = a > b ? b : a;
+    return (hi * 123 + lo * 51) >> 7;
+  }
+
+  // 打包频谱 -> 幅值, 换算回浮点路径单位: 乘以 2^shifts 再除以输入放大的 16 倍
+  void magnitude(const int16_t *x, uint32_t *mag, int shifts) const {
+    mag[0] = ((approx_mag(x[0], 0) << shifts) + 8) >> 4;
+    for (int k = 1; k < M; k++) {
+      mag[k] = ((approx_mag(x[2 * k], x[2 * k + 1]) << shifts) + 8) >> 4;
+    }
+  }
+
+private:
+  // 窗函数与旋转因子在编译期生成 (N/2 点复数 FFT 使用 W_N^k 的偶数项)
+  static constexpr cx::Table<int16_t, W> window_ = cx::hamming_q15<W>();
+  static constexpr cx::Table<int16_t, M> cos_ = cx::twiddle_cos_q15<N>();
+  static constexpr cx::Table<int16_t, M> sin_ = cx::twiddle_sin_q15<N>();
+};
@@ -0,0 +1,210 @@
+#pragma once
+#include "cx_math.h"
+#include "peak_interp.h"
+#include "real_fft.h"
+#include <stdint.h>
+
+/*
+ * 多速率八度滤波器组 (宽频带分析)
+ *
+ * 以高采样率 Fs (如 32kHz) 采集, 逐级半带滤波并 2 倍抽取:
+ *   第 0 级 Fs, 第 1 级 Fs/2, ... 第 s 级 Fs/2^s
+ * 每一级只分析自己奈奎斯特频率下面的一个八度 [Fs/2^(s+2), Fs/2^(s+1)),
+ * 即 N 点 FFT 的 bin [N/4, N/2), 再按对数间隔分成 BandsPerOctave 个频段.
+ * 所有级共用同一个小 FFT, 低频级的采样率低, 窗口按时间计更长, 相当于常 Q 分析.
+ *
+ * 半带滤波器: 23 抽头 Hamming 窗 sinc, 偶数位置系数为 0, 每个输出只需 6 次乘法;
+ * 0.2 Fs 处 -0.3 dB, 0.32 Fs 以上衰减超过 49 dB. 0.25~0.32 Fs 过渡带内的信号
+ * 会以较小的幅度混叠到下一级八度最高的几个 bin.
+ * 每个输入采样的滤波计算量约为 7 次乘加 (每级输出速率减半, 各级合计不超过输入速率).
+ *
+ * 幅值按 RefN 点 FFT 换算 (乘 RefN / N), 与 SpectrumConfig<RefN, ...> 的 FFT 幅值同一量级,
+ * 噪声底与放大倍数无需重新调整; 输出可直接交给 BandAnalyzer::update.
+ */
+
+namespace octave {
+
+const int HB_SIDE = 6;               // 半带滤波器单侧非零系数个数
+const int HB_TAPS = 4 * HB_SIDE - 1; // 抽头数 (23)
+
+// 半带滤波器单侧系数 h[±1], h[±3], ... h[±11] (中心系数为 0.5)
+template <typename T>
+constexpr cx::Table<T, HB_SIDE> make_halfband() {
+  cx::Table<T, HB_SIDE> t{};
+  double h[HB_SIDE] = {};
+  double sum = 0;
+  const int half = HB_TAPS / 2;
+  for (int j = 0; j < HB_SIDE; j++) {
+    int m = 2 * j + 1;
+    double x = (double)(m + half + 1) / (HB_TAPS + 1); // 窗位置 0~1 (两端不取 0)
+    double w = 0.54 - 0.46 * cx::cos(2 * cx::PI * x);
+    h[j] = cx::sin(cx::PI * m / 2) / (cx::PI * m) * w;
+    sum += 2 * h[j];
+  }
+  for (int j = 0; j < HB_SIDE; j++) {
+    t.v[j] = h[j] * 0.5 / sum; // 直流增益为 1
+  }
+  return t;
+}
+
+// 一个八度内的频段边界 (bin), 对数间隔, 从 N/4 到 N/2
+template <int N, int BandsPerOctave>
+constexpr cx::Table<uint16_t, BandsPerOctave + 1> make_octave_edges() {
+  cx::Table<uint16_t, BandsPerOctave + 1> t{};
+  double ratio = cx::root(2, BandsPerOctave);
+  double edge = N / 4;
+  for (int j = 0; j <= BandsPerOctave; j++) {
+    t.v[j] = (uint16_t)cx::round(edge);
+    edge *= ratio;
+  }
+  t.v[BandsPerOctave] = N / 2;
+  return t;
+}
+
+} // namespace octave
+
+template <typename T, uint32_t Fs, int Octaves, int BandsPerOctave, uint16_t N = 32, uint16_t RefN = 128>
+class OctaveBank {
+public:
+  static_assert(Octaves >= 1 && Octaves <= 12, "八度数超出范围");
+  static_assert(BandsPerOctave >= 1 && BandsPerOctave <= N / 4, "每个八度的频段数不能多于 N/4");
+  static_assert(N >= octave::HB_TAPS && (N & (N - 1)) == 0, "N 必须为 2 的幂且不小于半带滤波器抽头数");
+  static_assert(octave::HB_SIDE % 2 == 0, "halfband() 按两路累加");
+  static const int Bands = Octaves * BandsPerOctave;
+  static const uint32_t samplingFreq = Fs;
+  static const int BLOCK_MAX = 256; // push() 一次处理的最大采样数
+
+  OctaveBank() {
+    reset();
+  }
+
+  void reset() {
+    for (int s = 0; s < Octaves; s++) {
+      for (int i = 0; i < N; i++) {
+        ring_[s][i] = 0;
+      }
+      pos_[s] = 0;
+    }
+    phase_ = 0;
+  }
+
+  // 频段 i (0 为最低频) 的下边界频率 (Hz)
+  static float band_low_hz(int i) {
+    int s = Octaves - 1 - i / BandsPerOctave;
+    return (float)EDGES[i % BandsPerOctave] * Fs / ((uint32_t)N << s);
+  }
+
+  // 输入 n 个 Fs 采样率的采样 (以 0 为中心), 逐级滤波并 2 倍抽取
+  // 每级的环形缓冲同时是该级 FFT 的输入与半带滤波器的延迟线, 先处理完整块再进入下一级
+  void push(const T *x, int n) {
+    while (n > BLOCK_MAX) {
+      push(x, BLOCK_MAX);
+      x += BLOCK_MAX;
+      n -= BLOCK_MAX;
+    }
+    T a[BLOCK_MAX / 2 + 1];
+    T b[BLOCK_MAX / 2 + 1];
+    const T *in = x;
+    T *out = a;
+    for (int s = 0; s < Octaves && n > 0; s++) {
+      T *z = ring_[s];
+      uint16_t pos = pos_[s];
+      if (s == Octaves - 1) {
+        for (int i = 0; i < n; i++) {
+          z[pos] = in[i];
+          pos = (pos + 1) & (N - 1);
+        }
+        pos_[s] = pos;
+        break;
+      }
+      int i = 0;
+      int m = 0;
+      uint32_t bit = 1u << s;
+      if (phase_ & bit) { // 上次剩下一个未配对的采样
+        z[pos] = in[i++];
+        pos = (pos + 1) & (N - 1);
+        out[m++] = halfband(z, pos);
+        phase_ ^= bit;
+      }
+      // 每两个采样输出一个
+      for (; i + 1 < n; i += 2) {
+        z[pos] = in[i];
+        z[(pos + 1) & (N - 1)] = in[i + 1];
+        pos = (pos + 2) & (N - 1);
+        out[m++] = halfband(z, pos);
+      }
+      if (i < n) {
+        z[pos] = in[i];
+        pos = (pos + 1) & (N - 1);
+        phase_ ^= bit;
+      }
+      pos_[s] = pos;
+      in = out;
+      out = out == a ? b : a;
+      n = m;
+    }
+  }
+
+  // 对每一级的最近 N 个采样做 FFT, 读出各频段幅值 (低频在前),
+  // 返回最大幅值, peakFreq 为其频率 (Hz, 已做峰值插值)
+  T magnitudes(T *amp, T &peakFreq) {
+    const T gain = (T)RefN / N;
+    T frameMax = 0;
+    T peak[3] = {0, 0, 0}; // 最大幅值所在 bin 及左右相邻 bin, 最后再插值
+    int peakBins = 0;
+    T peakBin = 0;
+    T peakBinHz = 0;
+    for (int s = 0; s < Octaves; s++) {
+      // 按时间顺序 (最旧在前) 取出
+      for (int i = 0; i < N; i++) {
+        buf_[i] = ring_[s][(pos_[s] + i) & (N - 1)];
+      }
+      fft_.analyze(buf_);
+      T binHz = (T)Fs / ((uint32_t)N << s);
+      int base = (Octaves - 1 - s) * BandsPerOctave;
+      for (int j = 0; j < BandsPerOctave; j++) {
+        T maxAmp = 0;
+        for (int k = EDGES[j]; k < EDGES[j + 1]; k++) {
+          if (buf_[k] > maxAmp) {
+            maxAmp = buf_[k];
+          }
+          if (buf_[k] * gain > frameMax) {
+            frameMax = buf_[k] * gain;
+            peak[0] = buf_[k - 1];
+            peak[1] = buf_[k];
+            peak[2] = k + 1 < N / 2 ? buf_[k + 1] : 0;
+            peakBins = k + 1 < N / 2 ? 3 : 2;
+            peakBin = k;
+            peakBinHz = binHz;
+          }
+        }
+        amp[base + j] = maxAmp * gain;
+      }
+    }
+    peakFreq = (peakBin + peak_offset(peak, 1, peakBins, PEAK_LOG_PARABOLIC)) * peakBinHz;
+    return frameMax;
+  }
+
+private:
+  // 以最新的 HB_TAPS 个采样 (pos 为下一个写入位置) 计算一个半带滤波输出:
+  // y = 0.5 * z[c] + sum h[j] * (z[c - k] + z[c + k]), c 为延迟线中心, 两路累加缩短依赖链
+  static T halfband(const T *z, int pos) {
+    int c = pos - 1 - octave::HB_TAPS / 2;
+    T y0 = (T)0.5 * z[c & (N - 1)];
+    T y1 = 0;
+    for (int j = 0; j < octave::HB_SIDE; j += 2) {
+      y0 += HB[j] * (z[(c - 2 * j - 1) & (N - 1)] + z[(c + 2 * j + 1) & (N - 1)]);
+      y1 += HB[j + 1] * (z[(c - 2 * j - 3) & (N - 1)] + z[(c + 2 * j + 3) & (N - 1)]);
+    }
+    return y0 + y1;
+  }
+
+  static constexpr cx::Table<T, octave::HB_SIDE> HB = octave::make_halfband<T>();
+  static constexpr cx::Table<uint16_t, BandsPerOctave + 1> EDGES = octave::make_octave_edges<N, BandsPerOctave>();
+
+  RealFft<T, N> fft_;
+  T ring_[Octaves][N]; // 各级最近 N 个采样 (环形)
+  uint16_t pos_[Octaves]; // 各级下一个写入位置, 也是最旧采样的位置
+  uint32_t phase_;        // 第 s 位: 第 s 级抽取相位
+  T buf_[N];
+};
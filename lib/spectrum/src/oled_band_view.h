@@ -0,0 +1,93 @@
+#pragma once
+#include "bar_delta.h"
+#include "band_analyzer.h"
+#include "fast_db.h"
+#include <stdio.h>
+#include <string.h>
+
+/*
+ * esp32_SSD1306 的频谱画面 (128x64 单色 OLED)
+ *
+ * 顶部一行: 最大分贝, 峰值频率, 右上角时间; 下方为方块频谱与峰值线 (增量绘制).
+ * Display 为 Adafruit_SSD1306 或主机模拟器中的替身, 需提供:
+ *   void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+ *   void setTextSize(uint8_t s);
+ *   void setCursor(int16_t x, int16_t y);
+ *   size_t print(const char *s); // 透明背景, 默认 6x8 字体
+ * 只写显示缓冲, 刷新由调用方负责.
+ */
+template <class Display, int Bands, int Width, int Height, int HeaderH, int BlockH>
+class OledBandView {
+public:
+  static const uint16_t BLACK = 0; // SSD1306_BLACK
+  static const uint16_t WHITE = 1; // SSD1306_WHITE
+
+  OledBandView() : bars_({Width / Bands, Width / Bands - 2, BlockH, BlockH - 2, Height}) {
+    reset();
+  }
+
+  // 屏幕被其它内容清空后调用, 下一帧完整重绘
+  void reset() {
+    bars_.reset();
+    lastDbText_[0] = 0;
+  }
+
+  // timeText 为空串时右上角不显示时间
+  template <typename T>
+  void draw(Display &d, const SpectrumFrame<T, Bands> &f, const char *timeText) {
+    // 顶部文字只在内容变化时重绘
+    char dbText[12];
+    char freqText[12];
+    snprintf(dbText, sizeof(dbText), "%4.1fdB", (double)f.maxDb);
+    snprintf(freqText, sizeof(freqText), "%4dHz", (int)f.maxFreq);
+    if (strcmp(dbText, lastDbText_) != 0 || strcmp(freqText, lastFreqText_) != 0 ||
+        strcmp(timeText, lastTimeText_) != 0) {
+      strcpy(lastDbText_, dbText);
+      strcpy(lastFreqText_, freqText);
+      snprintf(lastTimeText_, sizeof(lastTimeText_), "%s", timeText);
+      d.fillRect(0, 0, Width, HeaderH, BLACK);
+      d.setTextSize(1);
+      d.setCursor(0, 0);
+      d.print(dbText);
+      d.setCursor(42, 0);
+      d.print(freqText);
+      d.setCursor(98, 0); // 靠近右侧边缘
+      d.print(lastTimeText_);
+    }
+
+    Canvas canvas = {d};
+    for (int i = 0; i < Bands; i++) {
+      int numBlocks = BlockLevels::at(f.bandDb[i]);
+      int peakY = PeakLevels::at(f.peakDb[i]);
+      peakY = peakY < HeaderH + 1 ? HeaderH + 1 : (peakY > Height - 1 ? Height - 1 : peakY);
+      bars_.draw(canvas, i, numBlocks, peakY);
+    }
+  }
+
+private:
+  // 频段值 (0~100) -> 方块数 / 峰值线 Y 坐标, 编译期查找表, 结果与 map() 相同
+  typedef LevelMap<0, Height - HeaderH - 2, BlockH> BlockLevels;
+  typedef LevelMap<Height, HeaderH + 1> PeakLevels;
+
+  // 增量绘制用的画布: 方块与峰值线为白色, 背景黑色
+  struct Canvas {
+    Display &d;
+    void fill(int x, int y, int w, int h, uint16_t color) {
+      d.fillRect(x, y, w, h, color);
+    }
+    uint16_t block_color(int) {
+      return WHITE;
+    }
+    uint16_t background() {
+      return BLACK;
+    }
+    uint16_t peak_color() {
+      return WHITE;
+    }
+  };
+
+  BarDelta<Bands> bars_;
+  char lastDbText_[12] = "";   // 上次绘制的分贝文字
+  char lastFreqText_[12] = ""; // 上次绘制的频率文字
+  char lastTimeText_[12] = ""; // 上次绘制的时间文字
+};
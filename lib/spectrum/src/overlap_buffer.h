@@ -0,0 +1,51 @@
+#pragma once
+#include <stdint.h>
+
+/*
+ * 重叠分帧用的环形采样缓冲 (STFT)
+ *
+ * 每次写入 hop 个新采样, 覆盖最旧的 hop 个, 再按时间顺序取出最近 N 个采样做 FFT.
+ * hop = N / 2 即 50% 重叠, hop = N / 4 即 75% 重叠, 每 hop 个新采样出一帧;
+ * hop = N 时与不重叠的整块采样完全相同.
+ */
+template <typename S, int N>
+class OverlapBuffer {
+public:
+  static_assert((N & (N - 1)) == 0, "N 必须为 2 的幂");
+
+  OverlapBuffer() {
+    reset();
+  }
+
+  void reset() {
+    for (int i = 0; i < N; i++) {
+      buf_[i] = 0;
+    }
+    pos_ = 0;
+  }
+
+  // 写入 n 个新采样, 每个先加上 offset (如去除 ADC 直流偏置)
+  template <typename U>
+  void push(const U *src, int n, int offset = 0) {
+    for (int i = 0; i < n; i++) {
+      buf_[pos_] = (S)(src[i] + offset);
+      pos_ = (pos_ + 1) & (N - 1);
+    }
+  }
+
+  // 按时间顺序 (最旧在前) 取出最近 N 个采样
+  template <typename T>
+  void copy_to(T *dst) const {
+    int k = 0;
+    for (int i = pos_; i < N; i++) {
+      dst[k++] = buf_[i];
+    }
+    for (int i = 0; i < pos_; i++) {
+      dst[k++] = buf_[i];
+    }
+  }
+
+private:
+  S buf_[N];
+  uint16_t pos_; // 下一个写入位置, 也是最旧采样的位置
+};
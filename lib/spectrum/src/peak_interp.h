@@ -0,0 +1,39 @@
+#pragma once
+#include "fast_db.h"
+
+/*
+ * 峰值频率的亚 bin 插值
+ *
+ * 取峰值 bin k 与左右相邻两点拟合抛物线, 顶点位置即为真实频率所在 (单位 bin):
+ *   p = (a - c) / (2 * (a - 2b + c)),  a, b, c = mag[k-1], mag[k], mag[k+1]
+ * PEAK_PARABOLIC 直接用幅值拟合; PEAK_LOG_PARABOLIC 先换算成分贝再拟合,
+ * Hamming 窗主瓣在对数域接近抛物线, 误差小一个数量级 (见 native 的 peak 模式).
+ * 只多 3 次 fast_db 与一次除法, 不需要更大的 FFT.
+ */
+enum PeakInterp {
+  PEAK_BIN = 0,           // 不插值, 取 bin 中心
+  PEAK_PARABOLIC = 1,     // 幅值抛物线
+  PEAK_LOG_PARABOLIC = 2, // 对数幅值抛物线
+};
+
+// 返回峰值相对 bin k 的偏移 (-0.5 ~ 0.5), bins 为有效频点数
+template <typename T>
+T peak_offset(const T *mag, int k, int bins, PeakInterp mode) {
+  if (mode == PEAK_BIN || k < 1 || k + 1 >= bins) {
+    return 0;
+  }
+  T a = mag[k - 1];
+  T b = mag[k];
+  T c = mag[k + 1];
+  if (mode == PEAK_LOG_PARABOLIC) {
+    a = fast_db(a);
+    b = fast_db(b);
+    c = fast_db(c);
+  }
+  T d = a - 2 * b + c;
+  if (d >= 0) {
+    return 0; // 不是局部极大 (平顶或噪声)
+  }
+  T p = (a - c) / (2 * d);
+  return p < (T)-0.5 ? (T)-0.5 : (p > (T)0.5 ? (T)0.5 : p);
+}
@@ -0,0 +1,113 @@
+#pragma once
+#include "cx_math.h"
+#include <math.h>
+#include <stdint.h>
+
+/*
+ * 实数输入 FFT (float / double)
+ *
+ * N 个实数采样按偶/奇交错当作 N/2 个复数做 N/2 点复数 FFT,
+ * 再经拆分 (split) 步骤得到前 N/2 个频点, 计算量约为 N 点复数 FFT 的一半,
+ * 且不需要 vImag 数组.
+ * 结果与 arduinoFFT 的 Windowing(Hamming) + Compute + ComplexToMagnitude
+ * 在 bin 0..N/2-1 上一致 (只差浮点舍入).
+ * W < N 时只对前 W 个采样加窗, 其余补零 (频点更密, 用于峰值频率插值).
+ */
+template <typename T, uint16_t N, uint16_t W = N>
+class RealFft {
+public:
+  static_assert(N >= 4 && (N & (N - 1)) == 0, "N 必须为 2 的幂");
+  static_assert(W >= 2 && W <= N, "窗长不能超过 N");
+  static const uint16_t M = N / 2; // 复数 FFT 点数
+
+  // 加窗 + FFT + 取模, x 只需填好前 W 个采样, 完成后 x[0..N/2) 为各频点幅值
+  void analyze(T *x) const {
+    window(x);
+    compute(x);
+    magnitude(x);
+  }
+
+  // 前 W 个采样乘以窗函数, 其余补零
+  void window(T *x) const {
+    for (int i = 0; i < W; i++) {
+      x[i] *= window_[i];
+    }
+    for (int i = W; i < N; i++) {
+      x[i] = 0;
+    }
+  }
+
+  // 原地实数 FFT, 输出打包格式: x[0] = X[0], x[1] = X[N/2] (均为实数),
+  // x[2k], x[2k+1] = X[k] 的实部与虚部 (k = 1..N/2-1)
+  void compute(T *x) const {
+    // 1. N/2 点复数 FFT (偶数样本为实部, 奇数样本为虚部)
+    for (int i = 1, j = 0; i < M; i++) {
+      int bit = M >> 1;
+      for (; j & bit; bit >>= 1) {
+        j ^= bit;
+      }
+      j |= bit;
+      if (i < j) {
+        T t = x[2 * i];
+        x[2 * i] = x[2 * j];
+        x[2 * j] = t;
+        t = x[2 * i + 1];
+        x[2 * i + 1] = x[2 * j + 1];
+        x[2 * j + 1] = t;
+      }
+    }
+    for (int len = 2; len <= M; len <<= 1) {
+      int half = len >> 1;
+      int step = N / len; // W_M^k = W_N^(2k)
+      for (int i = 0; i < M; i += len) {
+        for (int k = 0; k < half; k++) {
+          T c = cos_[k * step];
+          T s = sin_[k * step];
+          T *a = x + 2 * (i + k);
+          T *b = x + 2 * (i + k + half);
+          T tr = b[0] * c + b[1] * s;
+          T ti = b[1] * c - b[0] * s;
+          b[0] = a[0] - tr;
+          b[1] = a[1] - ti;
+          a[0] += tr;
+          a[1] += ti;
+        }
+      }
+    }
+
+    // 2. 拆分: X[k] = E + W^k * O, X[M-k] = conj(E - W^k * O)
+    //    E = (Z[k] + conj(Z[M-k])) / 2, O = (Z[k] - conj(Z[M-k])) / 2j
+    T z0 = x[0];
+    x[0] = z0 + x[1];
+    x[1] = z0 - x[1];
+    for (int k = 1; k <= M / 2; k++) {
+      T *p = x + 2 * k;
+      T *q = x + 2 * (M - k);
+      T er = (p[0] + q[0]) * (T)0.5;
+      T ei = (p[1] - q[1]) * (T)0.5;
+      T or_ = (p[1] + q[1]) * (T)0.5;
+      T oi = (q[0] - p[0]) * (T)0.5;
+      // W^k * O, W^k = cos - j*sin
+      T wr = or_ * cos_[k] + oi * sin_[k];
+      T wi = oi * cos_[k] - or_ * sin_[k];
+      p[0] = er + wr;
+      p[1] = ei + wi;
+      q[0] = er - wr; // k = M/2 时 p 与 q 相同, 结果为 conj(Z[M/2])
+      q[1] = wi - ei;
+    }
+  }
+
+  // 打包频谱 -> 幅值, 原地写入 x[0..N/2)
+  void magnitude(T *x) const {
+    x[0] = x[0] < 0 ? -x[0] : x[0];
+    for (int k = 1; k < M; k++) {
+      x[k] = sqrt(x[2 * k] * x[2 * k] + x[2 * k + 1] * x[2 * k + 1]);
+    }
+  }
+
+private:
+  // 窗函数与旋转因子在编译期生成 (N/2 点复数 FFT 使用 W_N^k 的偶数项)
+  static constexpr cx::Table<T, W> window_ = cx::hamming<T, W>();
+  static constexpr cx::Table<T, M> cos_ = cx::twiddle_cos<T, N>();
+  static constexpr cx::Table<T, M> sin_ = cx::twiddle_sin<T, N>();
+};
@@ -0,0 +1,116 @@
+#pragma once
+#include "cx_math.h"
+#include <math.h>
+#include <stdint.h>
+
+/*
+ * 滑动 DFT 滤波器组 (FFT 的替代分析引擎)
+ *
+ * 每个频段一个滤波器, 中心为该频段 bin 范围的几何中心, 每来一个采样更新一次:
+ *   S(n) = x(n) + w * S(n-1) - w^L * x(n-L),  w = r * e^(j*2*pi*c/N)
+ * 即最近 L 个采样在中心频率上的 DFT. 窗长 L = N / 频段宽度 (bin 数),
+ * 宽频段用短窗口, 主瓣覆盖整个频段 (频段边缘约 -4 dB), 相当于常 Q 滤波器组.
+ * 任意时刻都可以读出各频段幅值, 不必等采满一整块.
+ *
+ * 幅值已换算到与 Hamming 窗 FFT 的 bin 幅值相同的量级 (乘 N/L 与窗的相干增益 0.54),
+ * 可以直接交给 BandAnalyzer::update, 噪声底与放大倍数无需重新调整.
+ * r = 0.9999 的阻尼让浮点舍入误差随时间衰减 (时间常数约 1 万个采样), 不会累积漂移.
+ *
+ * 计算量: 每个采样每个频段 6 次乘法, 与频段数成正比; 读取幅值每个频段一次开方.
+ */
+
+namespace sdft {
+
+template <typename T>
+struct Coef {
+  T wr, wi;      // r * e^(j*omega)
+  T vr, vi;      // (r * e^(j*omega))^L, 离开窗口的采样的系数
+  T gain;        // 幅值换算系数
+  T centre;      // 中心位置 (bin)
+  uint16_t len;  // 窗长 L
+};
+
+template <typename T, class Config>
+constexpr cx::Table<Coef<T>, Config::bands> make_coefs() {
+  cx::Table<Coef<T>, Config::bands> t{};
+  const double R = 0.9999;
+  const int N = Config::samples;
+  for (int i = 0; i < Config::bands; i++) {
+    int lo = Config::binEdges[i];
+    int hi = Config::binEdges[i + 1] - 1;
+    double c = lo == hi ? lo : cx::root((double)hi / lo, 2) * lo; // sqrt(lo * hi)
+    int len = (int)cx::round((double)N / (hi - lo + 1));
+    double omega = 2 * cx::PI * c / N;
+    double rl = cx::ipow(R, len);
+    t.v[i].wr = R * cx::cos(omega);
+    t.v[i].wi = R * cx::sin(omega);
+    t.v[i].vr = rl * cx::cos(omega * len);
+    t.v[i].vi = rl * cx::sin(omega * len);
+    t.v[i].gain = 0.54 * N / len;
+    t.v[i].centre = c;
+    t.v[i].len = len;
+  }
+  return t;
+}
+
+} // namespace sdft
+
+template <typename T, class Config>
+class SlidingDftBank {
+public:
+  static_assert(Config::zeroPad == 1, "滑动 DFT 不支持补零");
+  static const int Bands = Config::bands;
+  static const int N = Config::samples;
+
+  SlidingDftBank() {
+    reset();
+  }
+
+  void reset() {
+    for (int i = 0; i < N; i++) {
+      hist_[i] = 0;
+    }
+    for (int i = 0; i < Bands; i++) {
+      sr_[i] = 0;
+      si_[i] = 0;
+    }
+    pos_ = 0;
+  }
+
+  // 输入一个采样 (以 0 为中心), 更新所有频段
+  void push(T x) {
+    for (int i = 0; i < Bands; i++) {
+      const sdft::Coef<T> &c = COEFS[i];
+      T old = hist_[(pos_ - c.len) & (N - 1)]; // x(n-L)
+      T r = sr_[i];
+      T im = si_[i];
+      sr_[i] = x + c.wr * r - c.wi * im - c.vr * old;
+      si_[i] = c.wr * im + c.wi * r - c.vi * old;
+    }
+    hist_[pos_] = x;
+    pos_ = (pos_ + 1) & (N - 1);
+  }
+
+  // 读出各频段幅值, 返回最大幅值, peakFreq 为其所在频段中心频率 (Hz)
+  T magnitudes(T *amp, T &peakFreq) const {
+    T frameMax = 0;
+    int peakBand = 0;
+    for (int i = 0; i < Bands; i++) {
+      amp[i] = sqrt(sr_[i] * sr_[i] + si_[i] * si_[i]) * COEFS[i].gain;
+      if (amp[i] > frameMax) {
+        frameMax = amp[i];
+        peakBand = i;
+      }
+    }
+    peakFreq = COEFS[peakBand].centre * Config::hzPerBin;
+    return frameMax;
+  }
+
+private:
+  static constexpr cx::Table<sdft::Coef<T>, Bands> COEFS = sdft::make_coefs<T, Config>();
+
+  T hist_[N]; // 最近 N 个采样 (环形)
+  T sr_[Bands];
+  T si_[Bands];
+  uint16_t pos_;
+};
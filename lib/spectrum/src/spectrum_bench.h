@@ -0,0 +1,177 @@
+#pragma once
+#include "band_analyzer.h"
+#include "fast_db.h"
+#include "octave_bank.h"
+#include "real_fft.h"
+#include "sliding_dft.h"
+#include <math.h>
+#include <stdint.h>
+
+/*
+ * 每帧热点路径的微基准: 分贝换算与频段值 -> 像素
+ *
+ * reference: 原来的写法, 20 * log10(x + 1) 与每个频段两次 map() (long 除法)
+ * fast:      fast_db 与 LevelMap 查表
+ * 两条路径处理同一组合成幅值, 结果以 Clock 的单位 (目标板上为 CPU 周期,
+ * 主机上为纳秒) 按帧平均. 只测差异部分, FFT 与平滑两边相同不计入.
+ *
+ * Clock 为可调用对象, 返回单调递增的 uint32_t 计数.
+ */
+
+struct HotPathBench {
+  uint32_t referencePerFrame; // 原写法每帧耗时
+  uint32_t fastPerFrame;      // 查表写法每帧耗时
+  int mismatches;             // 两种写法得到的方块数 / 峰值线位置不同的次数
+};
+
+template <typename T, int Bands, int BarMax, int BlockH, int PeakTop, int PeakBottom, class Clock>
+HotPathBench run_hotpath_bench(Clock now, int frames = 64, int repeat = 8) {
+  typedef LevelMap<0, BarMax, BlockH> BlockLevels;
+  typedef LevelMap<PeakBottom, PeakTop> PeakLevels;
+  const int FRAMES_MAX = 64;
+  if (frames > FRAMES_MAX) {
+    frames = FRAMES_MAX;
+  }
+
+  // 合成输入: 每帧一个最大幅值 (覆盖 0 ~ 60000) 与各频段 0~100 的值
+  static T peak[FRAMES_MAX];
+  static T level[FRAMES_MAX][Bands];
+  uint32_t seed = 12345;
+  for (int f = 0; f < frames; f++) {
+    seed = seed * 1103515245 + 12345;
+    peak[f] = (T)((seed >> 8) % 60000);
+    for (int b = 0; b < Bands; b++) {
+      seed = seed * 1103515245 + 12345;
+      level[f][b] = (T)((seed >> 8) % 10100) / 100 - (T)0.5;
+    }
+  }
+
+  HotPathBench r = {0, 0, 0};
+  volatile T dbSink = 0;
+  volatile int pxSink = 0;
+
+  uint32_t t0 = now();
+  for (int k = 0; k < repeat; k++) {
+    for (int f = 0; f < frames; f++) {
+      dbSink = 20 * log10(peak[f] + 1);
+      for (int b = 0; b < Bands; b++) {
+        long bar = (long)level[f][b] * BarMax / 100;
+        long py = (long)level[f][b] * (PeakTop - PeakBottom) / 100 + PeakBottom;
+        pxSink = bar / BlockH + py;
+      }
+    }
+  }
+  uint32_t t1 = now();
+  for (int k = 0; k < repeat; k++) {
+    for (int f = 0; f < frames; f++) {
+      dbSink = fast_db(peak[f]);
+      for (int b = 0; b < Bands; b++) {
+        pxSink = BlockLevels::at(level[f][b]) + PeakLevels::at(level[f][b]);
+      }
+    }
+  }
+  uint32_t t2 = now();
+
+  for (int f = 0; f < frames; f++) {
+    for (int b = 0; b < Bands; b++) {
+      long v = (long)level[f][b];
+      if (v < 0) {
+        continue; // map() 对负数的结果由调用处的 constrain 截断, 查表直接截到 0
+      }
+      if (BlockLevels::at(level[f][b]) != v * BarMax / 100 / BlockH ||
+          PeakLevels::at(level[f][b]) != v * (PeakTop - PeakBottom) / 100 + PeakBottom) {
+        r.mismatches++;
+      }
+    }
+  }
+  (void)dbSink;
+  (void)pxSink;
+
+  r.referencePerFrame = (t1 - t0) / (frames * repeat);
+  r.fastPerFrame = (t2 - t1) / (frames * repeat);
+  return r;
+}
+
+/*
+ * 分析引擎对比: 每 N 个采样的耗时 (同样以 Clock 为单位)
+ *
+ * fft:  采满 N 点后 加窗 + 实数 FFT + 取模 + 频段计算, 每 N 个采样出一帧
+ * sdft: 每个采样更新滑动 DFT 滤波器组, 每 hop 个采样读一次幅值并做频段计算
+ */
+struct EngineBench {
+  uint32_t fftPerBlock;
+  uint32_t sdftPerBlock;
+};
+
+template <typename T, class Config, class Clock>
+EngineBench run_engine_bench(Clock now, int hop = Config::samples, int blocks = 32) {
+  const int N = Config::samples;
+  static RealFft<T, Config::fftSize, N> fft;
+  static SlidingDftBank<T, Config> bank;
+  static BandAnalyzer<T, Config> bands({60, 6.0, 2.0, 0.9, 0.3});
+  static T pcm[N];
+  static T buf[Config::fftSize];
+  typename BandAnalyzer<T, Config>::Frame f;
+  T amp[Config::bands];
+  T peakFreq;
+
+  uint32_t seed = 1;
+  for (int i = 0; i < N; i++) {
+    seed = seed * 1103515245 + 12345;
+    pcm[i] = (T)((int)((seed >> 16) % 2001) - 1000);
+  }
+
+  EngineBench r = {0, 0};
+  uint32_t t0 = now();
+  for (int b = 0; b < blocks; b++) {
+    for (int i = 0; i < N; i++) {
+      buf[i] = pcm[i];
+    }
+    fft.analyze(buf);
+    bands.process(buf, b * 32, f);
+  }
+  uint32_t t1 = now();
+  for (int b = 0; b < blocks; b++) {
+    for (int i = 0; i < N; i++) {
+      bank.push(pcm[i]);
+      if ((i + 1) % hop == 0) {
+        T frameMax = bank.magnitudes(amp, peakFreq);
+        bands.update(amp, frameMax, peakFreq, b * 32, f);
+      }
+    }
+  }
+  uint32_t t2 = now();
+
+  r.fftPerBlock = (t1 - t0) / blocks;
+  r.sdftPerBlock = (t2 - t1) / blocks;
+  return r;
+}
+
+/*
+ * 八度滤波器组: 每帧 (Config::frameUs 时长, 即 Bank::samplingFreq 下的若干采样) 的耗时,
+ * 包括逐级半带抽取与各级小 FFT, 可与 run_engine_bench 的 fftPerBlock 直接比较
+ */
+template <typename T, class Config, class Bank, class Clock>
+uint32_t run_octave_bench(Clock now, int blocks = 32) {
+  constexpr int FRAME = (uint64_t)Bank::samplingFreq * Config::frameUs / 1000000;
+  static Bank bank;
+  static BandAnalyzer<T, Config> bands({60, 6.0, 2.0, 0.9, 0.3});
+  static T pcm[FRAME];
+  typename BandAnalyzer<T, Config>::Frame f;
+  T amp[Bank::Bands];
+  T peakFreq;
+
+  uint32_t seed = 1;
+  for (int i = 0; i < FRAME; i++) {
+    seed = seed * 1103515245 + 12345;
+    pcm[i] = (T)((int)((seed >> 16) % 2001) - 1000);
+  }
+
+  uint32_t t0 = now();
+  for (int b = 0; b < blocks; b++) {
+    bank.push(pcm, FRAME);
+    T frameMax = bank.magnitudes(amp, peakFreq);
+    bands.update(amp, frameMax, peakFreq, b * 32, f);
+  }
+  return (now() - t0) / blocks;
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include "cx_math.h"
+#include <stdint.h>
+
+/*
+ * 频谱参数 (编译期)
+ *
+ * SpectrumConfig<采样点数, 采样频率, 频段数> 在编译期生成对数间隔的
+ * bin 边界表与每个 bin 的频率宽度, 修改 SAMPLES / SAMPLING_FREQ / BAND_NUM
+ * 后频段映射自动跟着变化, 不再需要手写表格.
+ *
+ * 边界生成: 从 FirstBin 到 N/2, 每一步按 "剩余范围 / 剩余频段数" 重新计算
+ * 等比系数, 且每个频段至少占 1 个 bin. 低频段受 bin 分辨率限制各占 1 个 bin,
+ * 多出来的比例自动分摊给高频段.
+ * 两块板子的默认参数 (128 点 / 16 频段 / FirstBin 2) 沿用原先手工调整的表,
+ * 补零时按倍数放大, 显示的频段映射与改动前完全相同:
+ *   2 3 4 5 7 9 11 13 16 19 23 28 34 41 49 58 64
+ * 其它参数按上面的规则生成, 如 256 点 / 16 频段: 2 3 4 5 6 8 10 13 17 22 28 36 46 59 76 99 128
+ *
+ * ZeroPad: FFT 补零倍数. 每帧仍取 Samples 个采样, 后面补零到 Samples * ZeroPad 点再做 FFT,
+ * 频点间隔缩小为 1 / ZeroPad (频率分辨力不变, 但峰值位置更准), FirstBin 仍按未补零的 bin 计.
+ */
+namespace cx {
+
+template <int Bands>
+constexpr Table<uint16_t, Bands + 1> log_bin_edges(int first, int last) {
+  Table<uint16_t, Bands + 1> t{};
+  t.v[0] = first;
+  int prev = first;
+  for (int i = 1; i < Bands; i++) {
+    double ratio = root((double)last / prev, Bands - i + 1);
+    int next = (int)round(prev * ratio);
+    if (next < prev + 1) {
+      next = prev + 1;
+    }
+    if (next > last - (Bands - i)) {
+      next = last - (Bands - i); // 给剩下的频段至少各留 1 个 bin
+    }
+    t.v[i] = next;
+    prev = next;
+  }
+  t.v[Bands] = last;
+  return t;
+}
+
+// 原先手工调整的 128 点 / 16 频段边界表
+constexpr uint16_t LEGACY_EDGES_128_16[17] = {2, 3, 4, 5, 7, 9, 11, 13, 16, 19, 23, 28, 34, 41, 49, 58, 64};
+
+template <uint16_t Samples, int Bands, uint16_t FirstBin, uint16_t ZeroPad>
+constexpr Table<uint16_t, Bands + 1> default_bin_edges() {
+  if constexpr (Samples == 128 && Bands == 16 && FirstBin == 2) {
+    Table<uint16_t, Bands + 1> t{};
+    for (int i = 0; i <= Bands; i++) {
+      t.v[i] = LEGACY_EDGES_128_16[i] * ZeroPad;
+    }
+    return t;
+  } else {
+    return log_bin_edges<Bands>(FirstBin * ZeroPad, Samples * ZeroPad / 2);
+  }
+}
+
+} // namespace cx
+
+template <uint16_t Samples, uint32_t Fs, int Bands, uint16_t FirstBin = 2, uint16_t ZeroPad = 1>
+struct SpectrumConfig {
+  static_assert(Samples >= 8 && (Samples & (Samples - 1)) == 0, "Samples 必须为 2 的幂");
+  static_assert(ZeroPad >= 1 && (ZeroPad & (ZeroPad - 1)) == 0, "ZeroPad 必须为 2 的幂");
+  static_assert(FirstBin >= 1 && Bands <= Samples * ZeroPad / 2 - FirstBin * ZeroPad, "频段数不能多于可用的 bin 数");
+
+  static constexpr uint16_t samples = Samples;                // 每帧 (窗口) 采样点数
+  static constexpr uint16_t zeroPad = ZeroPad;
+  static constexpr uint16_t fftSize = Samples * ZeroPad;      // FFT 点数
+  static constexpr uint32_t samplingFreq = Fs;
+  static constexpr int bands = Bands;
+  static constexpr uint16_t bins = fftSize / 2;               // 有效频点数
+  static constexpr float hzPerBin = (float)Fs / fftSize;      // 每个 bin 的频率宽度
+  static constexpr uint32_t frameUs = 1000000ull * Samples / Fs; // 一帧采样时长
+
+  // 频段 i 对应 bin [binEdges[i], binEdges[i + 1])
+  static constexpr cx::Table<uint16_t, Bands + 1> binEdges = cx::default_bin_edges<Samples, Bands, FirstBin, ZeroPad>();
+};
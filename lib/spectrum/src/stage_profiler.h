@@ -0,0 +1,128 @@
+#pragma once
+#include <stdint.h>
+
+/*
+ * 分阶段耗时统计 (采集 / 加窗 / FFT / 取模 / 频段计算 / 绘制 / 刷屏 等)
+ *
+ * 每个阶段记录次数、最小、最大、总和, 以及对数直方图 (每 2 倍分 4 档, 分辨率约 19%),
+ * p99 取直方图中第 99 百分位所在档的上界 (不超过最大值).
+ * 计时单位由调用方决定 (CPU 周期或微秒), 不依赖 Arduino, 可在主机上编译.
+ *
+ * 多任务 / 多核: 每个阶段只由一个任务写入 (record), 打印或网页接口在其它任务中只读
+ * (summary, 读到的可能是更新到一半的数据, 只影响一次显示);
+ * request_reset 只设置标志, 由写入方在下一次 record 时清零, 不需要加锁.
+ * 调用处通过宏包裹, 关闭时整个统计 (包括本类) 都不参与编译.
+ */
+
+struct StageSummary {
+  uint32_t count;
+  uint32_t min;
+  uint32_t avg;
+  uint32_t p99;
+  uint32_t max;
+};
+
+template <int Stages>
+class StageProfiler {
+public:
+  static const int BUCKETS = 128; // 2^0 ~ 2^32, 每 2 倍 4 档
+
+  StageProfiler() {
+    for (int s = 0; s < Stages; s++) {
+      clear(stage_[s]);
+    }
+  }
+
+  void record(int stage, uint32_t ticks) {
+    Stage &st = stage_[stage];
+    if (st.resetPending) {
+      clear(st);
+    }
+    st.count++;
+    st.sum += ticks;
+    if (ticks < st.min) {
+      st.min = ticks;
+    }
+    if (ticks > st.max) {
+      st.max = ticks;
+    }
+    uint16_t &h = st.hist[bucket(ticks)];
+    if (h != 0xFFFF) {
+      h++;
+    }
+  }
+
+  StageSummary summary(int stage) const {
+    const Stage &st = stage_[stage];
+    StageSummary r = {st.count, 0, 0, 0, 0};
+    if (st.count == 0 || st.resetPending) {
+      r.count = 0;
+      return r;
+    }
+    r.min = st.min;
+    r.max = st.max;
+    r.avg = (uint32_t)(st.sum / st.count);
+    uint32_t rank = st.count - st.count / 100; // 第 99 百分位: 至少 99% 的样本不超过它
+    uint32_t seen = 0;
+    for (int b = 0; b < BUCKETS; b++) {
+      seen += st.hist[b];
+      if (seen >= rank) {
+        uint32_t upper = bucket_upper(b);
+        r.p99 = upper < st.max ? upper : st.max;
+        break;
+      }
+    }
+    if (seen < rank) {
+      r.p99 = st.max; // 直方图计数饱和
+    }
+    return r;
+  }
+
+  // 开始新的统计周期 (所有阶段)
+  void request_reset() {
+    for (int s = 0; s < Stages; s++) {
+      stage_[s].resetPending = true;
+    }
+  }
+
+  // 0~3 各占一档, 之后每 2 倍分 4 档
+  static int bucket(uint32_t v) {
+    if (v < 4) {
+      return v;
+    }
+    int n = 31 - __builtin_clz(v);
+    return 4 * (n - 1) + ((v >> (n - 2)) & 3);
+  }
+
+  static uint32_t bucket_upper(int b) {
+    if (b < 4) {
+      return b;
+    }
+    int n = b / 4 + 1;
+    uint64_t upper = ((uint64_t)(5 + b % 4) << (n - 2)) - 1;
+    return upper > 0xFFFFFFFFu ? 0xFFFFFFFFu : (uint32_t)upper;
+  }
+
+private:
+  struct Stage {
+    volatile bool resetPending;
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;
+    uint16_t hist[BUCKETS];
+  };
+
+  static void clear(Stage &st) {
+    st.count = 0;
+    st.min = 0xFFFFFFFFu;
+    st.max = 0;
+    st.sum = 0;
+    for (int b = 0; b < BUCKETS; b++) {
+      st.hist[b] = 0;
+    }
+    st.resetPending = false;
+  }
+
+  Stage stage_[Stages];
+};
@@ -0,0 +1,102 @@
+#pragma once
+#include "bar_delta.h"
+#include "band_analyzer.h"
+#include "fast_db.h"
+#include <stdio.h>
+#include <string.h>
+
+/*
+ * rp2040-zero_ST7735S 的频谱画面 (160x80 RGB565 TFT)
+ *
+ * 顶部一行: 最大分贝与峰值频率; 下方为按高度着色的方块频谱与白色峰值线 (增量绘制).
+ * Display 为 st7735 驱动的包装或主机模拟器中的替身, 需提供:
+ *   void fill_rect(int x, int y, int w, int h, uint16_t color);
+ *   void draw_string(int x, int y, const char *s, uint16_t color); // 5x7 字体, 字距 6
+ * 只写显示缓冲, 刷新由调用方负责.
+ */
+template <class Display, int Bands, int Width, int Height, int HeaderH, int BlockH>
+class TftBandView {
+public:
+  // colorOffset: 颜色偏移, 底部绿色 顶部红色
+  explicit TftBandView(uint8_t colorOffset)
+      : bars_({Width / Bands, Width / Bands - 2, BlockH, BlockH - 2, Height}), colorOffset_(colorOffset) {
+  }
+
+  // 屏幕被其它内容清空后调用, 下一帧完整重绘
+  void reset() {
+    bars_.reset();
+    lastDbText_[0] = 0;
+  }
+
+  // 颜色轮转换函数 (输入0-255 输出RGB565颜色)
+  static uint16_t wheel(uint8_t pos) {
+    pos = 255 - pos;
+    if (pos < 85) {
+      // RGB565 approximation
+      return (((255 - pos * 3) & 0xF8) << 8) | ((pos * 3 >> 2) << 5) | (0);
+    }
+    if (pos < 170) {
+      pos -= 85;
+      return (0 << 11) | (((pos * 3) >> 2) << 5) | ((255 - pos * 3) >> 3);
+    }
+    pos -= 170;
+    return (((pos * 3) & 0xF8) << 8) | (((255 - pos * 3) >> 2) << 5) | 0;
+  }
+
+  // 频谱绘制 (只绘制与上一帧不同的部分)
+  template <typename T>
+  void draw(Display &d, const SpectrumFrame<T, Bands> &f) {
+    // 1. 顶部文字只在内容变化时重绘
+    char dbText[20];
+    char freqText[20];
+    snprintf(dbText, sizeof(dbText), "%4.1f dB", (double)f.maxDb);
+    snprintf(freqText, sizeof(freqText), "%4d Hz", (int)f.maxFreq);
+    if (strcmp(dbText, lastDbText_) != 0 || strcmp(freqText, lastFreqText_) != 0) {
+      d.fill_rect(0, 0, Width, HeaderH, 0x0000);
+      d.draw_string(5, 2, dbText, 0xFFFF);
+      d.draw_string(90, 2, freqText, 0xFFFF);
+      strcpy(lastDbText_, dbText);
+      strcpy(lastFreqText_, freqText);
+    }
+
+    // 2. 增量绘制频谱条与峰值线
+    Canvas canvas = {d, colorOffset_};
+    for (int i = 0; i < Bands; i++) {
+      int numBlocks = BlockLevels::at(f.bandDb[i]);
+
+      // 映射峰值 Y 坐标
+      int peakY = PeakLevels::at(f.peakDb[i]);
+      peakY = peakY < HeaderH + 1 ? HeaderH + 1 : (peakY > Height - 1 ? Height - 1 : peakY);
+
+      bars_.draw(canvas, i, numBlocks, peakY);
+    }
+  }
+
+private:
+  // 频段值 (0~100) -> 方块数 / 峰值线 Y 坐标, 编译期查找表, 结果与 map() 相同
+  typedef LevelMap<0, Height - HeaderH - 4, BlockH> BlockLevels;
+  typedef LevelMap<Height, HeaderH + 1> PeakLevels;
+
+  // 增量绘制用的画布: 方块按高度着色, 背景黑色, 峰值线白色
+  struct Canvas {
+    Display &d;
+    uint8_t colorOffset;
+    void fill(int x, int y, int w, int h, uint16_t color) {
+      d.fill_rect(x, y, w, h, color);
+    }
+    uint16_t block_color(int b) {
+      return wheel(b * BlockH * 2 + colorOffset);
+    }
+    uint16_t background() {
+      return 0x0000;
+    }
+    uint16_t peak_color() {
+      return 0xFFFF;
+    }
+  };
+
+  BarDelta<Bands> bars_;
+  uint8_t colorOffset_;
+  char lastDbText_[20] = "";   // 上次绘制的分贝文字
+  char lastFreqText_[20] = ""; // 上次绘制的频率文字
+};
@@ -0,0 +1,139 @@
+#pragma once
+#include <oled_band_view.h>
+#include <tft_band_view.h>
+#include "sim_display.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+/*
+ * 画面回归: 固定的频段/峰值序列驱动两种频谱画面, 每个场景得到帧缓冲的校验和 (FNV-1a)
+ *
+ * 每帧同时与清屏后完整重绘的结果逐像素对比 (增量绘制不应改变画面),
+ * 各场景的校验和与下面 GOLDEN_SCENES 中记录的期望值对比 (绘制结果不应变化).
+ * 由 native 程序的 frames 模式与 test/test_frames 共用.
+ * 有意改动画面时: 运行 frames 模式, 用 out.ppm 确认新画面无误后, 把打印的校验和更新到 GOLDEN_SCENES.
+ */
+
+#define SCENE_BANDS 16  // 频段数量
+#define SCENE_COUNT 5   // 场景数
+#define SCENE_FRAMES 24 // 每个场景的帧数
+
+typedef OledBandView<SimOled, SCENE_BANDS, 128, 64, 10, 5> OledView; // esp32_SSD1306 的画面
+typedef TftBandView<SimTft, SCENE_BANDS, 160, 80, 12, 7> TftView;    // rp2040-zero_ST7735S 的画面
+
+struct GoldenScene {
+  const char *name;
+  uint32_t oled; // SimOled 各帧显存的校验和
+  uint32_t tft;  // SimTft 各帧 RGB565 帧缓冲的校验和
+};
+
+const GoldenScene GOLDEN_SCENES[SCENE_COUNT] = {
+    {"silence", 0x93d946d6, 0xad366ec3},
+    {"full", 0xb5a05bd7, 0xcff85a2f},
+    {"ramp", 0x10c3bd51, 0x5c107cbd},
+    {"clamp", 0x9baec30c, 0x0554f981},
+    {"random", 0x78f78e69, 0x33f71319},
+};
+
+inline uint32_t fnv1a(const void *data, size_t len, uint32_t h = 2166136261u) {
+  const uint8_t *p = (const uint8_t *)data;
+  for (size_t i = 0; i < len; i++) {
+    h = (h ^ p[i]) * 16777619u;
+  }
+  return h;
+}
+
+// 第 k 帧的频段值/峰值: 覆盖 0 与 100 两端、超出范围的输入、峰值低于方块以及逐帧随机起伏
+inline void golden_frame(int scene, int k, SpectrumFrame<double, SCENE_BANDS> &f) {
+  static uint32_t seed;
+  if (k == 0) {
+    seed = 1 + scene;
+  }
+  for (int i = 0; i < SCENE_BANDS; i++) {
+    double v;
+    switch (scene) {
+    case 0: // 静音
+      v = 0;
+      break;
+    case 1: // 满幅
+      v = 100;
+      break;
+    case 2: // 斜坡, 逐帧右移
+      v = ((i + k) % SCENE_BANDS) * 100.0 / (SCENE_BANDS - 1);
+      break;
+    case 3: // 超出 0~100 的输入 (截断到两端)
+      v = (i + k) % 2 ? 140 : -25;
+      break;
+    default: // 随机起伏
+      seed = seed * 1103515245 + 12345;
+      v = (seed >> 8) % 10100 / 100.0;
+      break;
+    }
+    f.bandDb[i] = v;
+    f.peakDb[i] = scene == 4 && i % 3 == 0 ? v / 2 : v + (k * 7 + i * 3) % 20; // 部分频段峰值低于方块
+  }
+  f.maxDb = scene * 17.3 + k * 0.7;
+  f.maxFreq = 31 + (scene * 977 + k * 113) % 1969;
+  f.currentDb = f.maxDb;
+}
+
+struct SceneResult {
+  uint32_t oled;  // 校验和
+  uint32_t tft;
+  int mismatches; // 与完整重绘不同的帧数 (两种画面合计)
+};
+
+// 绘制一个场景的全部帧, out 不为空时每帧追加 OLED 与 TFT 各一张 PPM
+inline SceneResult run_scene(int scene, FILE *out = nullptr) {
+  static SimOled oled, oledRef;
+  static SimTft tft, tftRef;
+  static OledView oledView, oledRefView;
+  static TftView tftView(55), tftRefView(55);
+  SpectrumFrame<double, SCENE_BANDS> fd;
+  SpectrumFrame<float, SCENE_BANDS> ff;
+  SceneResult r = {2166136261u, 2166136261u, 0};
+
+  // 每个场景从黑屏开始, 结果不依赖之前运行过哪些场景
+  oled.clearDisplay();
+  oledView.reset();
+  tft.fill_rect(0, 0, SimTft::WIDTH, SimTft::HEIGHT, 0x0000);
+  tftView.reset();
+
+  for (int k = 0; k < SCENE_FRAMES; k++) {
+    golden_frame(scene, k, fd);
+    for (int i = 0; i < SCENE_BANDS; i++) {
+      ff.bandDb[i] = fd.bandDb[i];
+      ff.peakDb[i] = fd.peakDb[i];
+    }
+    ff.maxDb = fd.maxDb;
+    ff.maxFreq = fd.maxFreq;
+    const char *timeText = k % 2 ? "12:34" : "";
+
+    oledView.draw(oled, ff, timeText);
+    tftView.draw(tft, fd);
+    r.oled = fnv1a(oled.getBuffer(), SimOled::WIDTH * SimOled::HEIGHT / 8, r.oled);
+    r.tft = fnv1a(tft.framebuffer(), SimTft::WIDTH * SimTft::HEIGHT * 2, r.tft);
+
+    // 完整重绘作为参照
+    oledRef.clearDisplay();
+    oledRefView.reset();
+    oledRefView.draw(oledRef, ff, timeText);
+    tftRef.fill_rect(0, 0, SimTft::WIDTH, SimTft::HEIGHT, 0x0000);
+    tftRefView.reset();
+    tftRefView.draw(tftRef, fd);
+    if (memcmp(oled.getBuffer(), oledRef.getBuffer(), SimOled::WIDTH * SimOled::HEIGHT / 8) != 0) {
+      printf("  oled %s frame %d differs from full redraw\n", GOLDEN_SCENES[scene].name, k);
+      r.mismatches++;
+    }
+    if (memcmp(tft.framebuffer(), tftRef.framebuffer(), SimTft::WIDTH * SimTft::HEIGHT * 2) != 0) {
+      printf("  tft  %s frame %d differs from full redraw\n", GOLDEN_SCENES[scene].name, k);
+      r.mismatches++;
+    }
+    if (out) {
+      oled.write_ppm(out);
+      tft.write_ppm(out);
+    }
+  }
+  return r;
+}
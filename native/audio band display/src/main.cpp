@@ -0,0 +1,335 @@
+#include <band_analyzer.h>
+#include <fft_q15.h>
+#include <oled_band_view.h>
+#include <real_fft.h>
+#include <spectrum_bench.h>
+#include <spectrum_config.h>
+#include <stage_profiler.h>
+#include <tft_band_view.h>
+#include "frame_scenes.h"
+#include "sim_display.h"
+#include "wav_file.h"
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * 主机端频谱分析链
+ *
+ * 用合成信号 (逐个频段的正弦 + 白噪声) 驱动与板子上相同的
+ * 加窗 -> FFT -> 频段计算 流程, 打印每帧的频段值, 并给出 Q15 定点 FFT
+ * 相对浮点 FFT 的最大频段误差, 超过 Q15_TOLERANCE 时返回 1.
+ * 单元测试见 test/ (pio test -e native).
+ *
+ * 参数 bench: 运行微基准 (分贝换算 + 频段值转像素的原写法与查表对比,
+ *             FFT / 滑动 DFT / 八度滤波器组三种分析引擎对比)
+ * 参数 peak:  用合成正弦扫频验证顶部频率读数的峰值插值
+ *             (浮点/Q15 FFT x 补零 1/2/4 倍 x 三种插值方式, 打印最大与均方根误差)
+ * 参数 sim oled|tft <in.wav> [out.ppm] [gain]:
+ *             把 WAV 文件当作麦克风输入, 经与板子相同的分析链与频谱画面
+ *             (oled: esp32_SSD1306, tft: rp2040-zero_ST7735S, 默认参数) 绘制到内存帧缓冲,
+ *             每帧追加一张 PPM 到 out.ppm, 最后打印各阶段每帧耗时 (us)
+ * 参数 frames [out.ppm]:
+ *             用固定的频段/峰值序列驱动两种频谱画面, 每个场景的帧缓冲校验和与
+ *             frame_scenes.h 中记录的期望值对比, 并与每帧清屏后完整重绘的结果逐像素对比,
+ *             任一不符时返回 1; 校验和不同时用 out.ppm 查看差异 (test/test_frames 做同样的检查)
+ */
+
+#define SAMPLES 128        // FFT采样点数 必须为2的幂
+#define SAMPLING_FREQ 4000 // 采样频率 (Hz)
+#define BAND_NUM 16        // 频段数量
+#define Q15_TOLERANCE 10   // Q15 与浮点的频段高度之差上限 (0~100, 见 fft_q15.h)
+
+typedef SpectrumConfig<SAMPLES, SAMPLING_FREQ, BAND_NUM> Spectrum;
+
+// 与 esp32_SSD1306/audio band display 相同的参数
+const BandParams params = {60, 6.0, 2.0, 0.9, 0.3};
+
+float vReal[SAMPLES];         // 浮点 FFT 输入/幅值
+int16_t qReal[SAMPLES];       // 定点 FFT 输入/打包频谱
+uint32_t qMag[SAMPLES / 2];   // 定点 FFT 幅值输出
+float qMagF[SAMPLES / 2];     // 定点幅值转为浮点, 供频段计算
+RealFft<float, SAMPLES> FFT;  // 实数 FFT 对象
+FftQ15<SAMPLES> qFFT;         // 定点 FFT 对象
+
+// 合成一帧 12 位 ADC 采样 (已去除直流偏置): freq 为 0 时只有噪声
+void synth_frame(int frame, float freq, float amp, int16_t *out) {
+  for (int i = 0; i < SAMPLES; i++) {
+    float t = (float)(frame * SAMPLES + i) / SAMPLING_FREQ;
+    float v = amp * sin(2 * M_PI * freq * t) + (rand() % 41 - 20);
+    if (v > 2047) {
+      v = 2047;
+    }
+    if (v < -2048) {
+      v = -2048;
+    }
+    out[i] = (int16_t)v;
+  }
+}
+
+// 打印一帧频段值, 每个频段一个字符 (0~9 对应 0~100)
+void print_frame(const char *tag, float freq, const SpectrumFrame<float, BAND_NUM> &f) {
+  char bars[BAND_NUM + 1];
+  for (int i = 0; i < BAND_NUM; i++) {
+    int v = (int)(f.bandDb[i] / 10);
+    bars[i] = '0' + (v > 9 ? 9 : v);
+  }
+  bars[BAND_NUM] = 0;
+  printf("%-5s %6.0fHz  |%s|  %5.1fdB %5.0fHz\n", tag, freq, bars, f.maxDb, f.maxFreq);
+}
+
+// 主机计时 (纳秒)
+uint32_t host_ns() {
+  using namespace std::chrono;
+  return (uint32_t)duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+// 与 esp32 (128x64 OLED) / rp2040 (160x80 TFT) 相同的显示参数
+void run_bench() {
+  HotPathBench oled = run_hotpath_bench<float, BAND_NUM, 64 - 10 - 2, 5, 10 + 1, 64>(host_ns, 64, 2000);
+  HotPathBench tft = run_hotpath_bench<double, BAND_NUM, 80 - 12 - 4, 7, 12 + 1, 80>(host_ns, 64, 2000);
+  printf("hot path ns/frame  float: log10+map %u  fast_db+LUT %u  mismatches %d\n", oled.referencePerFrame,
+         oled.fastPerFrame, oled.mismatches);
+  printf("hot path ns/frame double: log10+map %u  fast_db+LUT %u  mismatches %d\n", tft.referencePerFrame,
+         tft.fastPerFrame, tft.mismatches);
+
+  // 分析引擎: 每 128 个采样的耗时, 滑动 DFT 每 32 个采样出一帧
+  EngineBench e16 = run_engine_bench<float, SpectrumConfig<SAMPLES, SAMPLING_FREQ, 16>>(host_ns, 32, 2000);
+  EngineBench e32 = run_engine_bench<float, SpectrumConfig<SAMPLES, SAMPLING_FREQ, 32>>(host_ns, 32, 2000);
+  printf("engine ns/%d samples  16 bands: fft %u  sdft %u\n", SAMPLES, e16.fftPerBlock, e16.sdftPerBlock);
+  printf("engine ns/%d samples  32 bands: fft %u  sdft %u\n", SAMPLES, e32.fftPerBlock, e32.sdftPerBlock);
+
+  // 八度滤波器组: 32kHz 采样, 8 个八度 (62.5Hz~16kHz), 每帧 (32ms) 的耗时
+  uint32_t oct = run_octave_bench<float, Spectrum, OctaveBank<float, 32000, 8, 2>>(host_ns, 2000);
+  printf("octave bank ns/frame  32kHz 16 bands (62Hz~16kHz): %u\n", oct);
+}
+
+// 一种 FFT 配置下的扫频: 200~1800Hz 每 1.7Hz 一个正弦, 经 BandAnalyzer::process 读出 maxFreq
+template <uint16_t Pad, bool Q15>
+void peak_sweep(PeakInterp interp) {
+  typedef SpectrumConfig<SAMPLES, SAMPLING_FREQ, BAND_NUM, 2, Pad> Config;
+  const int N = Config::fftSize;
+  static RealFft<float, N, SAMPLES> fft;
+  static FftQ15<N, SAMPLES> qfft;
+  static float x[N];
+  static int16_t q[N];
+  static uint32_t mag[N / 2];
+  BandAnalyzer<float, Config> bands(params, 0, SAMPLES, interp);
+  typename BandAnalyzer<float, Config>::Frame f;
+  int16_t pcm[SAMPLES];
+  float maxErr = 0;
+  double sumSq = 0;
+  int count = 0;
+  srand(2);
+
+  for (float freq = 200; freq <= 1800; freq += 1.7f, count++) {
+    synth_frame(count, freq, 1200, pcm);
+    if (Q15) {
+      memcpy(q, pcm, sizeof(pcm));
+      qfft.analyze(q, mag);
+      for (int i = 0; i < N / 2; i++) {
+        x[i] = mag[i];
+      }
+    } else {
+      for (int i = 0; i < SAMPLES; i++) {
+        x[i] = pcm[i];
+      }
+      fft.analyze(x);
+    }
+    bands.process(x, count + 1, f);
+    float err = fabs(f.maxFreq - freq);
+    if (err > maxErr) {
+      maxErr = err;
+    }
+    sumSq += err * err;
+  }
+  printf("%-5s pad %d  %-13s  max %5.2fHz  rms %5.2fHz\n", Q15 ? "q15" : "float", Pad,
+         interp == PEAK_BIN ? "bin" : (interp == PEAK_PARABOLIC ? "parabolic" : "log-parabolic"), maxErr,
+         sqrt(sumSq / count));
+}
+
+// 模拟器: 与两块板子相同的分析参数 (ANALYSIS_ENGINE 0, 不重叠, 不补零)
+enum SimStage { SIM_FFT, SIM_BANDS, SIM_RENDER, SIM_STAGES };
+const char *simStageNames[SIM_STAGES] = {"fft", "bands", "render"};
+
+void sim_draw(SimOled &d, OledBandView<SimOled, BAND_NUM, 128, 64, 10, 5> &view, const SpectrumFrame<float, BAND_NUM> &f) {
+  view.draw(d, f, "");
+}
+void sim_draw(SimTft &d, TftBandView<SimTft, BAND_NUM, 160, 80, 12, 7> &view, const SpectrumFrame<double, BAND_NUM> &f) {
+  view.draw(d, f);
+}
+
+template <typename T, class Display, class View>
+int simulate(WavFile &wav, View &view, const BandParams &p, const char *outPath, float gain) {
+  static RealFft<T, SAMPLES> fft;
+  static T x[SAMPLES];
+  static Display display;
+  BandAnalyzer<T, Spectrum> bands(p);
+  SpectrumFrame<T, BAND_NUM> f;
+  StageProfiler<SIM_STAGES> prof;
+  FILE *out = nullptr;
+  if (outPath) {
+    out = fopen(outPath, "wb");
+    if (!out) {
+      fprintf(stderr, "cannot write %s\n", outPath);
+      return 1;
+    }
+  }
+
+  int16_t pcm[SAMPLES];
+  int frame = 0;
+  while (wav.read(pcm, SAMPLES, SAMPLING_FREQ, gain) == SAMPLES) {
+    uint32_t now = (uint64_t)frame * Spectrum::frameUs / 1000;
+    uint32_t t0 = host_ns();
+    for (int i = 0; i < SAMPLES; i++) {
+      x[i] = pcm[i];
+    }
+    fft.analyze(x);
+    uint32_t t1 = host_ns();
+    bands.process(x, now, f);
+    uint32_t t2 = host_ns();
+    sim_draw(display, view, f);
+    uint32_t t3 = host_ns();
+    prof.record(SIM_FFT, t1 - t0);
+    prof.record(SIM_BANDS, t2 - t1);
+    prof.record(SIM_RENDER, t3 - t2);
+    if (out) {
+      display.write_ppm(out);
+    }
+    frame++;
+  }
+  if (out) {
+    fclose(out);
+  }
+
+  printf("frames %d (%.2fs of audio at %dHz, frame %uus)\n", frame, frame * Spectrum::frameUs / 1e6, SAMPLING_FREQ,
+         (unsigned)Spectrum::frameUs);
+  for (int i = 0; i < SIM_STAGES; i++) {
+    StageSummary s = prof.summary(i);
+    printf("  %-7s min %8.2f  avg %8.2f  p99 %8.2f  max %8.2f us\n", simStageNames[i], s.min / 1e3, s.avg / 1e3,
+           s.p99 / 1e3, s.max / 1e3);
+  }
+  return 0;
+}
+
+int run_sim(int argc, char **argv) {
+  if (argc < 4) {
+    fprintf(stderr, "usage: %s sim oled|tft <in.wav> [out.ppm] [gain]\n", argv[0]);
+    return 2;
+  }
+  WavFile wav;
+  if (!wav.open(argv[3])) {
+    return 1;
+  }
+  const char *outPath = argc > 4 ? argv[4] : nullptr;
+  float gain = argc > 5 ? atof(argv[5]) : 1;
+  if (strcmp(argv[2], "oled") == 0) {
+    static OledBandView<SimOled, BAND_NUM, 128, 64, 10, 5> view;
+    return simulate<float, SimOled>(wav, view, params, outPath, gain);
+  }
+  if (strcmp(argv[2], "tft") == 0) {
+    // rp2040-zero_ST7735S 的参数: 噪声抑制 30, 放大 8 倍, 颜色偏移 55
+    static TftBandView<SimTft, BAND_NUM, 160, 80, 12, 7> view(55);
+    return simulate<double, SimTft>(wav, view, {30, 8.0, 2.0, 0.9, 0.3}, outPath, gain);
+  }
+  fprintf(stderr, "unknown display %s (oled|tft)\n", argv[2]);
+  return 2;
+}
+
+// 画面回归: 固定输入序列 -> 帧缓冲校验和, 与 frame_scenes.h 中记录的期望值对比
+int run_frames(const char *outPath) {
+  FILE *out = outPath ? fopen(outPath, "wb") : nullptr;
+  int mismatches = 0;
+  int changed = 0;
+  for (int scene = 0; scene < SCENE_COUNT; scene++) {
+    const GoldenScene &g = GOLDEN_SCENES[scene];
+    SceneResult r = run_scene(scene, out);
+    bool ok = r.oled == g.oled && r.tft == g.tft;
+    printf("%-8s oled %08x  tft %08x  %s\n", g.name, r.oled, r.tft, ok ? "ok" : "CHANGED");
+    if (!ok) {
+      printf("         expected oled %08x  tft %08x\n", g.oled, g.tft);
+      changed++;
+    }
+    mismatches += r.mismatches;
+  }
+  if (out) {
+    fclose(out);
+  }
+  printf("frames %d  incremental vs full redraw mismatches %d  scenes changed %d\n", SCENE_COUNT * SCENE_FRAMES,
+         mismatches, changed);
+  return mismatches || changed ? 1 : 0;
+}
+
+template <uint16_t Pad, bool Q15>
+void peak_sweep_all() {
+  peak_sweep<Pad, Q15>(PEAK_BIN);
+  peak_sweep<Pad, Q15>(PEAK_PARABOLIC);
+  peak_sweep<Pad, Q15>(PEAK_LOG_PARABOLIC);
+}
+
+int main(int argc, char **argv) {
+  if (argc > 1 && strcmp(argv[1], "bench") == 0) {
+    run_bench();
+    return 0;
+  }
+  if (argc > 1 && strcmp(argv[1], "peak") == 0) {
+    peak_sweep_all<1, false>();
+    peak_sweep_all<2, false>();
+    peak_sweep_all<4, false>();
+    peak_sweep_all<1, true>();
+    peak_sweep_all<2, true>();
+    return 0;
+  }
+  if (argc > 1 && strcmp(argv[1], "sim") == 0) {
+    return run_sim(argc, argv);
+  }
+  if (argc > 1 && strcmp(argv[1], "frames") == 0) {
+    return run_frames(argc > 2 ? argv[2] : nullptr);
+  }
+
+  BandAnalyzer<float, Spectrum> floatBands(params);
+  BandAnalyzer<float, Spectrum> q15Bands(params);
+  SpectrumFrame<float, BAND_NUM> ff;
+  SpectrumFrame<float, BAND_NUM> qf;
+  int16_t pcm[SAMPLES];
+  float maxErr = 0;
+  srand(1);
+
+  // 依次扫过每个频段的中心频率, 每个频率保持 8 帧
+  int frame = 0;
+  for (int band = 0; band < BAND_NUM; band++) {
+    int bin = (Spectrum::binEdges[band] + Spectrum::binEdges[band + 1]) / 2;
+    float freq = bin * Spectrum::hzPerBin;
+    for (int k = 0; k < 8; k++, frame++) {
+      synth_frame(frame, freq, 1200, pcm);
+      uint32_t now = (uint64_t)frame * Spectrum::frameUs / 1000;
+
+      for (int i = 0; i < SAMPLES; i++) {
+        vReal[i] = pcm[i];
+      }
+      FFT.analyze(vReal);
+      floatBands.process(vReal, now, ff);
+
+      memcpy(qReal, pcm, sizeof(qReal));
+      qFFT.analyze(qReal, qMag);
+      for (int i = 0; i < SAMPLES / 2; i++) {
+        qMagF[i] = qMag[i];
+      }
+      q15Bands.process(qMagF, now, qf);
+
+      for (int i = 0; i < BAND_NUM; i++) {
+        float err = fabs(ff.bandDb[i] - qf.bandDb[i]);
+        if (err > maxErr) {
+          maxErr = err;
+        }
+      }
+    }
+    print_frame("float", freq, ff);
+    print_frame("q15", freq, qf);
+  }
+
+  printf("frames %d  q15 vs float max band error %.2f (of 100, limit %d)\n", frame, maxErr, Q15_TOLERANCE);
+  return maxErr > Q15_TOLERANCE ? 1 : 0;
+}
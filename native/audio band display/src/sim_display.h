@@ -0,0 +1,189 @@
+#pragma once
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+/*
+ * 显示驱动的主机替身: 只实现频谱画面用到的接口, 绘制到内存帧缓冲,
+ * 每帧可追加为一张 PPM (P6) 写入同一个文件, 得到可直接播放的帧序列:
+ *   ffmpeg -f image2pipe -c:v ppm -framerate 31.25 -i frames.ppm -vf scale=iw*4:-1:flags=neighbor out.gif
+ *
+ * SimOled: Adafruit_SSD1306 的子集 (128x64 单色, 默认 6x8 字体, 透明背景)
+ * SimTft:  st7735.h 中 tft_fill_rect / tft_draw_string 的替身 (160x80 RGB565)
+ * 字形取自各自驱动的 5x7 点阵, 只收录频谱画面顶部文字用到的字符.
+ */
+
+namespace sim {
+
+struct Glyph {
+  char c;
+  uint8_t col[5]; // 每列一个字节, bit0 在上
+};
+
+// Adafruit GFX 默认字体 (glcdfont) 中的对应字符
+const Glyph OLED_GLYPHS[] = {
+    {'0', {0x3E, 0x51, 0x49, 0x45, 0x3E}}, {'1', {0x00, 0x42, 0x7F, 0x40, 0x00}},
+    {'2', {0x42, 0x61, 0x51, 0x49, 0x46}}, {'3', {0x21, 0x41, 0x45, 0x4B, 0x31}},
+    {'4', {0x18, 0x14, 0x12, 0x7F, 0x10}}, {'5', {0x27, 0x45, 0x45, 0x45, 0x39}},
+    {'6', {0x3C, 0x4A, 0x49, 0x49, 0x30}}, {'7', {0x01, 0x71, 0x09, 0x05, 0x03}},
+    {'8', {0x36, 0x49, 0x49, 0x49, 0x36}}, {'9', {0x06, 0x49, 0x49, 0x29, 0x1E}},
+    {'.', {0x00, 0x60, 0x60, 0x00, 0x00}}, {':', {0x00, 0x36, 0x36, 0x00, 0x00}},
+    {'-', {0x08, 0x08, 0x08, 0x08, 0x08}}, {'B', {0x7F, 0x49, 0x49, 0x49, 0x36}},
+    {'H', {0x7F, 0x08, 0x08, 0x08, 0x7F}}, {'d', {0x38, 0x44, 0x44, 0x48, 0x7F}},
+    {'z', {0x44, 0x64, 0x54, 0x4C, 0x44}},
+};
+
+// rp2040-zero_ST7735S/audio band display/src/st7735.cpp 中的 font5x7 (未收录的字符不绘制)
+const Glyph TFT_GLYPHS[] = {
+    {'0', {0x3E, 0x51, 0x49, 0x45, 0x3E}}, {'1', {0x00, 0x42, 0x7F, 0x40, 0x00}},
+    {'2', {0x42, 0x61, 0x51, 0x49, 0x46}}, {'3', {0x21, 0x41, 0x45, 0x4B, 0x31}},
+    {'4', {0x18, 0x14, 0x12, 0x7F, 0x10}}, {'5', {0x27, 0x45, 0x45, 0x45, 0x39}},
+    {'6', {0x3C, 0x4A, 0x49, 0x49, 0x30}}, {'7', {0x01, 0x71, 0x09, 0x05, 0x03}},
+    {'8', {0x36, 0x49, 0x49, 0x49, 0x36}}, {'9', {0x06, 0x49, 0x49, 0x29, 0x1E}},
+    {'.', {0x00, 0x60, 0x60, 0x00, 0x00}}, {' ', {0x00, 0x00, 0x00, 0x00, 0x00}},
+    {'A', {0x7E, 0x11, 0x11, 0x11, 0x7E}}, {'B', {0x7F, 0x49, 0x49, 0x49, 0x36}},
+    {'d', {0x38, 0x44, 0x44, 0x44, 0x7F}}, {'F', {0x7F, 0x09, 0x09, 0x09, 0x01}},
+    {'H', {0x7F, 0x08, 0x08, 0x08, 0x7F}}, {'i', {0x44, 0x7D, 0x40, 0x00, 0x00}},
+    {'z', {0x44, 0x64, 0x54, 0x4C, 0x44}},
+};
+
+template <int N>
+const uint8_t *find_glyph(const Glyph (&table)[N], char c) {
+  for (int i = 0; i < N; i++) {
+    if (table[i].c == c) {
+      return table[i].col;
+    }
+  }
+  return nullptr;
+}
+
+inline void write_ppm_header(FILE *fp, int w, int h) {
+  fprintf(fp, "P6\n%d %d\n255\n", w, h);
+}
+
+} // namespace sim
+
+class SimOled {
+public:
+  static const int WIDTH = 128;
+  static const int HEIGHT = 64;
+
+  SimOled() {
+    clearDisplay();
+  }
+
+  void clearDisplay() {
+    memset(buf_, 0, sizeof(buf_));
+  }
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    for (int j = y; j < y + h; j++) {
+      for (int i = x; i < x + w; i++) {
+        pixel(i, j, color);
+      }
+    }
+  }
+  void setTextSize(uint8_t s) {
+    textSize_ = s;
+  }
+  void setCursor(int16_t x, int16_t y) {
+    cursorX_ = x;
+    cursorY_ = y;
+  }
+  size_t print(const char *s) {
+    size_t n = 0;
+    for (; *s; s++, n++) {
+      const uint8_t *g = sim::find_glyph(sim::OLED_GLYPHS, *s);
+      for (int i = 0; g && i < 5; i++) {
+        for (int j = 0; j < 8; j++) {
+          if (g[i] & (1 << j)) {
+            fillRect(cursorX_ + i * textSize_, cursorY_ + j * textSize_, textSize_, textSize_, 1);
+          }
+        }
+      }
+      cursorX_ += 6 * textSize_;
+    }
+    return n;
+  }
+
+  // 与 Adafruit_SSD1306::getBuffer() 相同的页格式: 每字节竖向 8 个像素, bit0 在上
+  const uint8_t *getBuffer() const {
+    return buf_;
+  }
+  bool get(int x, int y) const {
+    return buf_[(y / 8) * WIDTH + x] & (1 << (y & 7));
+  }
+
+  // 追加一帧 PPM (亮为白色)
+  void write_ppm(FILE *fp) const {
+    sim::write_ppm_header(fp, WIDTH, HEIGHT);
+    for (int y = 0; y < HEIGHT; y++) {
+      for (int x = 0; x < WIDTH; x++) {
+        uint8_t v = get(x, y) ? 255 : 0;
+        uint8_t rgb[3] = {v, v, v};
+        fwrite(rgb, 1, 3, fp);
+      }
+    }
+  }
+
+private:
+  void pixel(int x, int y, uint16_t color) {
+    if (x < 0 || y < 0 || x >= WIDTH || y >= HEIGHT) {
+      return;
+    }
+    uint8_t &b = buf_[(y / 8) * WIDTH + x];
+    b = color ? (b | (1 << (y & 7))) : (b & ~(1 << (y & 7)));
+  }
+
+  uint8_t buf_[WIDTH * HEIGHT / 8];
+  int cursorX_ = 0;
+  int cursorY_ = 0;
+  int textSize_ = 1;
+};
+
+class SimTft {
+public:
+  static const int WIDTH = 160;
+  static const int HEIGHT = 80;
+
+  SimTft() {
+    fill_rect(0, 0, WIDTH, HEIGHT, 0x0000);
+  }
+
+  void fill_rect(int x, int y, int w, int h, uint16_t color) {
+    for (int j = y < 0 ? 0 : y; j < y + h && j < HEIGHT; j++) {
+      for (int i = x < 0 ? 0 : x; i < x + w && i < WIDTH; i++) {
+        fb_[j * WIDTH + i] = color;
+      }
+    }
+  }
+  void draw_string(int x, int y, const char *s, uint16_t color) {
+    for (; *s; s++, x += 6) {
+      const uint8_t *g = sim::find_glyph(sim::TFT_GLYPHS, *s);
+      for (int i = 0; g && i < 5; i++) {
+        for (int j = 0; j < 7; j++) {
+          if (g[i] & (1 << j)) {
+            fill_rect(x + i, y + j, 1, 1, color);
+          }
+        }
+      }
+    }
+  }
+
+  const uint16_t *framebuffer() const {
+    return fb_;
+  }
+
+  // 追加一帧 PPM (RGB565 展开为 8 位)
+  void write_ppm(FILE *fp) const {
+    sim::write_ppm_header(fp, WIDTH, HEIGHT);
+    for (int i = 0; i < WIDTH * HEIGHT; i++) {
+      uint16_t c = fb_[i];
+      uint8_t rgb[3] = {(uint8_t)((c >> 11) * 255 / 31), (uint8_t)(((c >> 5) & 63) * 255 / 63),
+                        (uint8_t)((c & 31) * 255 / 31)};
+      fwrite(rgb, 1, 3, fp);
+    }
+  }
+
+private:
+  uint16_t fb_[WIDTH * HEIGHT];
+};
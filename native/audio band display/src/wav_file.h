@@ -0,0 +1,129 @@
+#pragma once
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+/*
+ * WAV 文件 -> 板子 ADC 采样 (模拟器的麦克风替身)
+ *
+ * 支持 16 位 PCM 与 32 位浮点, 多声道取平均. 整个文件读入内存,
+ * 按目标采样率线性插值重采样 (板子上同样没有抗混叠滤波),
+ * 满幅对应 12 位 ADC 的 +-2048, 输出与板子上 "ADC 读数 - 2048" 相同的值.
+ */
+class WavFile {
+public:
+  // 读入整个文件, 失败时打印原因并返回 false
+  bool open(const char *path) {
+    FILE *fp = fopen(path, "rb");
+    if (!fp) {
+      fprintf(stderr, "cannot open %s\n", path);
+      return false;
+    }
+    bool ok = parse(fp);
+    fclose(fp);
+    if (!ok) {
+      fprintf(stderr, "%s: unsupported or broken WAV (need 16-bit PCM or 32-bit float)\n", path);
+    }
+    pos_ = 0;
+    return ok;
+  }
+
+  int rate() const {
+    return rate_;
+  }
+  double seconds() const {
+    return rate_ ? (double)data_.size() / rate_ : 0;
+  }
+
+  // 以 targetRate 读出 n 个采样, gain 为输入放大倍数; 文件结束时返回实际读出的个数
+  int read(int16_t *dst, int n, int targetRate, float gain = 1) {
+    double step = (double)rate_ / targetRate;
+    int i = 0;
+    for (; i < n; i++, pos_ += step) {
+      size_t k = (size_t)pos_;
+      if (k + 1 >= data_.size()) {
+        break;
+      }
+      double frac = pos_ - k;
+      double v = (data_[k] + (data_[k + 1] - data_[k]) * frac) * 2048 * gain;
+      dst[i] = (int16_t)(v > 2047 ? 2047 : (v < -2048 ? -2048 : lround(v)));
+    }
+    return i;
+  }
+
+private:
+  static uint32_t le32(const uint8_t *p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+  }
+  static uint16_t le16(const uint8_t *p) {
+    return p[0] | (p[1] << 8);
+  }
+
+  bool parse(FILE *fp) {
+    uint8_t hdr[12];
+    if (fread(hdr, 1, 12, fp) != 12 || memcmp(hdr, "RIFF", 4) != 0 || memcmp(hdr + 8, "WAVE", 4) != 0) {
+      return false;
+    }
+    int format = 0;
+    int channels = 0;
+    int bits = 0;
+    uint8_t chunk[8];
+    while (fread(chunk, 1, 8, fp) == 8) {
+      uint32_t size = le32(chunk + 4);
+      if (memcmp(chunk, "fmt ", 4) == 0) {
+        uint8_t fmt[16];
+        if (size < 16 || fread(fmt, 1, 16, fp) != 16) {
+          return false;
+        }
+        format = le16(fmt);
+        channels = le16(fmt + 2);
+        rate_ = le32(fmt + 4);
+        bits = le16(fmt + 14);
+        if (format == 0xFFFE && size >= 26) {
+          uint8_t ext[10];
+          if (fread(ext, 1, 10, fp) != 10) {
+            return false;
+          }
+          format = le16(ext + 8); // WAVE_FORMAT_EXTENSIBLE: 子格式 GUID 的前两个字节
+          size -= 10;
+        }
+        fseek(fp, (size - 16 + 1) & ~1u, SEEK_CUR);
+      } else if (memcmp(chunk, "data", 4) == 0) {
+        bool pcm16 = format == 1 && bits == 16;
+        bool f32 = format == 3 && bits == 32;
+        if (!(pcm16 || f32) || channels < 1 || rate_ <= 0) {
+          return false;
+        }
+        int frameBytes = channels * bits / 8;
+        std::vector<uint8_t> raw(size);
+        size_t got = fread(raw.data(), 1, size, fp);
+        data_.resize(got / frameBytes);
+        for (size_t i = 0; i < data_.size(); i++) {
+          const uint8_t *p = &raw[i * frameBytes];
+          float sum = 0;
+          for (int c = 0; c < channels; c++) {
+            if (pcm16) {
+              sum += (int16_t)le16(p + 2 * c) / 32768.0f;
+            } else {
+              uint32_t u = le32(p + 4 * c);
+              float f;
+              memcpy(&f, &u, 4);
+              sum += f;
+            }
+          }
+          data_[i] = sum / channels;
+        }
+        return !data_.empty();
+      } else {
+        fseek(fp, (size + 1) & ~1u, SEEK_CUR);
+      }
+    }
+    return false;
+  }
+
+  std::vector<float> data_; // 各声道平均后的采样 (-1 ~ 1)
+  int rate_ = 0;
+  double pos_ = 0;          // 下一个输出采样在原始采样中的位置
+};
@@ -0,0 +1,164 @@
+#include <band_analyzer.h>
+#include <spectrum_config.h>
+#include <unity.h>
+
+/*
+ * BandAnalyzer: 固定的幅值输入 -> 频段值/峰值线/顶部读数
+ * 参数与 esp32_SSD1306/audio band display 相同, 期望值按 band_analyzer.h 中的公式手算.
+ */
+
+typedef SpectrumConfig<128, 4000, 16> Spectrum;
+typedef BandAnalyzer<float, Spectrum> Analyzer;
+
+const BandParams params = {60, 6.0, 2.0, 0.9, 0.3};
+
+float mag[Spectrum::bins];
+
+void setUp() {
+  for (int i = 0; i < Spectrum::bins; i++) {
+    mag[i] = 0;
+  }
+}
+
+void tearDown() {
+}
+
+// (amp - noiseFloor) / 2048 * dbMult * 100, 截到 0~100
+float level(float amp) {
+  float db = (amp - params.noiseFloor) * params.dbMult * 100 / 2048;
+  return db < 0 ? 0 : (db > 100 ? 100 : db);
+}
+
+// 两块板子的默认频段映射与原先手工调整的表相同
+void test_default_bin_edges() {
+  const uint16_t legacy[17] = {2, 3, 4, 5, 7, 9, 11, 13, 16, 19, 23, 28, 34, 41, 49, 58, 64};
+  TEST_ASSERT_EQUAL_UINT16_ARRAY(legacy, Spectrum::binEdges.data(), 17);
+}
+
+// 单个 bin 只点亮所在的频段, 第一帧按上升系数平滑
+void test_single_bin_lights_its_band() {
+  Analyzer a(params, 500, Spectrum::samples, PEAK_BIN);
+  Analyzer::Frame f;
+  mag[20] = 400; // 频段 9: bin [19, 23)
+  a.process(mag, 0, f);
+  for (int i = 0; i < 16; i++) {
+    float expect = i == 9 ? level(400) * 0.9f : 0;
+    TEST_ASSERT_FLOAT_WITHIN(1e-3, expect, f.bandDb[i]);
+    // 峰值线不高于频段时照常下落 (与原先的绘制一致, 低于底部的部分不显示)
+    TEST_ASSERT_FLOAT_WITHIN(1e-3, i == 9 ? expect : -params.peakFall, f.peakDb[i]);
+  }
+}
+
+// 超出量程的幅值截到 100, 低于噪声底的为 0
+void test_clamps_to_range() {
+  Analyzer a(params);
+  Analyzer::Frame f;
+  mag[2] = 50;     // 频段 0, 低于噪声底
+  mag[60] = 1e6f;  // 频段 15
+  a.process(mag, 0, f);
+  TEST_ASSERT_FLOAT_WITHIN(1e-3, 0, f.bandDb[0]);
+  TEST_ASSERT_FLOAT_WITHIN(1e-3, 90, f.bandDb[15]);
+}
+
+// 上升/下降两种平滑系数, 峰值线每帧下落 peakFall
+void test_smoothing_and_peak_fall() {
+  Analyzer a(params);
+  Analyzer::Frame f;
+  float target = level(400);
+  float band = 0;
+  mag[20] = 400;
+  for (int k = 0; k < 3; k++) {
+    a.process(mag, k * 32, f);
+    band = target * 0.9f + band * 0.1f;
+    TEST_ASSERT_FLOAT_WITHIN(1e-3, band, f.bandDb[9]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3, band, f.peakDb[9]);
+  }
+  float peak = band;
+  mag[20] = 0;
+  for (int k = 3; k < 8; k++) {
+    a.process(mag, k * 32, f);
+    band = band * 0.7f;
+    peak -= params.peakFall;
+    TEST_ASSERT_FLOAT_WITHIN(1e-3, band, f.bandDb[9]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3, peak, f.peakDb[9]);
+  }
+}
+
+// 顶部的分贝与频率每 peakIntervalMs 才更新一次
+void test_header_hold() {
+  Analyzer a(params, 500, Spectrum::samples, PEAK_BIN);
+  Analyzer::Frame f;
+  mag[20] = 400;
+  a.process(mag, 0, f);
+  TEST_ASSERT_FLOAT_WITHIN(1e-3, 0, f.maxFreq);
+  TEST_ASSERT_FLOAT_WITHIN(0.02, 20 * log10(401.0), f.currentDb); // fast_db(x) = 20 * log10(x + 1)
+
+  a.process(mag, 501, f);
+  TEST_ASSERT_FLOAT_WITHIN(1e-3, 20 * Spectrum::hzPerBin, f.maxFreq);
+  TEST_ASSERT_FLOAT_WITHIN(0.02, 20 * log10(401.0), f.maxDb);
+
+  // 保持期内峰值移动, 读数不变
+  mag[20] = 0;
+  mag[40] = 800;
+  a.process(mag, 900, f);
+  TEST_ASSERT_FLOAT_WITHIN(1e-3, 20 * Spectrum::hzPerBin, f.maxFreq);
+  a.process(mag, 1002, f);
+  TEST_ASSERT_FLOAT_WITHIN(1e-3, 40 * Spectrum::hzPerBin, f.maxFreq);
+  TEST_ASSERT_FLOAT_WITHIN(0.02, 20 * log10(801.0), f.maxDb);
+}
+
+// 峰值 bin 按插值方式偏移: 左右对称时不偏移, 右侧更高时向右
+void test_peak_interpolation() {
+  Analyzer a(params, 0, Spectrum::samples, PEAK_LOG_PARABOLIC);
+  Analyzer::Frame f;
+  mag[29] = 100;
+  mag[30] = 400;
+  mag[31] = 100;
+  a.process(mag, 1, f);
+  TEST_ASSERT_FLOAT_WITHIN(0.01, 30 * Spectrum::hzPerBin, f.maxFreq);
+  mag[31] = 300;
+  a.process(mag, 2, f);
+  TEST_ASSERT_TRUE(f.maxFreq > 30 * Spectrum::hzPerBin);
+  TEST_ASSERT_TRUE(f.maxFreq < 30.5f * Spectrum::hzPerBin);
+}
+
+// 低于 bin 4 的低频不参与顶部读数
+void test_low_bins_ignored_for_header() {
+  Analyzer a(params, 0, Spectrum::samples, PEAK_BIN);
+  Analyzer::Frame f;
+  mag[3] = 2000;
+  mag[10] = 300;
+  a.process(mag, 1, f);
+  TEST_ASSERT_FLOAT_WITHIN(1e-3, 10 * Spectrum::hzPerBin, f.maxFreq);
+}
+
+// 重叠分帧 (hop = 64) 时按实际时间换算平滑系数与下落速度
+void test_rescale_for_hop() {
+  BandParams r = Analyzer::rescale(params, 64);
+  TEST_ASSERT_FLOAT_WITHIN(1e-5, 1 - sqrt(0.1), r.smoothUp);
+  TEST_ASSERT_FLOAT_WITHIN(1e-5, 1 - sqrt(0.7), r.smoothDown);
+  TEST_ASSERT_FLOAT_WITHIN(1e-5, 1.0, r.peakFall);
+
+  // 两个半帧的上升与一个整帧相同
+  Analyzer whole(params);
+  Analyzer half(params, 500, 64);
+  Analyzer::Frame fw, fh;
+  mag[20] = 400;
+  whole.process(mag, 0, fw);
+  half.process(mag, 0, fh);
+  half.process(mag, 16, fh);
+  TEST_ASSERT_FLOAT_WITHIN(1e-3, fw.bandDb[9], fh.bandDb[9]);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_default_bin_edges);
+  RUN_TEST(test_single_bin_lights_its_band);
+  RUN_TEST(test_clamps_to_range);
+  RUN_TEST(test_smoothing_and_peak_fall);
+  RUN_TEST(test_header_hold);
+  RUN_TEST(test_peak_interpolation);
+  RUN_TEST(test_low_bins_ignored_for_header);
+  RUN_TEST(test_rescale_for_hop);
+  return UNITY_END();
+}
@@ -0,0 +1,47 @@
+#include "../../src/frame_scenes.h"
+#include <unity.h>
+
+/*
+ * 两种频谱画面的回归测试: 每个场景的帧缓冲校验和须与 GOLDEN_SCENES 相同,
+ * 且增量绘制与完整重绘逐帧一致. 场景与期望值见 src/frame_scenes.h.
+ */
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+void check_scene(int scene) {
+  SceneResult r = run_scene(scene);
+  const GoldenScene &g = GOLDEN_SCENES[scene];
+  TEST_ASSERT_EQUAL_INT_MESSAGE(0, r.mismatches, g.name);
+  TEST_ASSERT_EQUAL_HEX32_MESSAGE(g.oled, r.oled, g.name);
+  TEST_ASSERT_EQUAL_HEX32_MESSAGE(g.tft, r.tft, g.name);
+}
+
+void test_scene_silence() {
+  check_scene(0);
+}
+void test_scene_full() {
+  check_scene(1);
+}
+void test_scene_ramp() {
+  check_scene(2);
+}
+void test_scene_clamp() {
+  check_scene(3);
+}
+void test_scene_random() {
+  check_scene(4);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_scene_silence);
+  RUN_TEST(test_scene_full);
+  RUN_TEST(test_scene_ramp);
+  RUN_TEST(test_scene_clamp);
+  RUN_TEST(test_scene_random);
+  return UNITY_END();
+}
@@ -0,0 +1,136 @@
+#include <band_analyzer.h>
+#include <fft_q15.h>
+#include <real_fft.h>
+#include <spectrum_config.h>
+#include <math.h>
+#include <string.h>
+#include <unity.h>
+
+/*
+ * Q15 定点 FFT 与浮点 FFT 经同一 BandAnalyzer 后的频段高度 (0~100) 之差
+ * 不超过 fft_q15.h 中给出的 10 (约一个方块). 两块板子的参数各测一遍.
+ */
+
+#define SAMPLES 128
+#define SAMPLING_FREQ 4000
+#define TOLERANCE 10
+
+typedef SpectrumConfig<SAMPLES, SAMPLING_FREQ, 16> Spectrum;
+
+const BandParams OLED_PARAMS = {60, 6.0, 2.0, 0.9, 0.3}; // esp32_SSD1306
+const BandParams TFT_PARAMS = {30, 8.0, 2.0, 0.9, 0.3};  // rp2040-zero_ST7735S
+
+uint32_t seed;
+
+// 可复现的伪随机数 (不依赖平台的 rand)
+uint32_t next_rand() {
+  seed = seed * 1103515245 + 12345;
+  return seed >> 8;
+}
+
+// 一帧 12 位 ADC 采样 (已去除直流偏置): 正弦 + 幅度 noise 的白噪声
+void synth(int frame, float freq, float amp, int noise, int16_t *out) {
+  for (int i = 0; i < SAMPLES; i++) {
+    float t = (float)(frame * SAMPLES + i) / SAMPLING_FREQ;
+    float v = amp * sin(2 * M_PI * freq * t) + (int)(next_rand() % (2 * noise + 1)) - noise;
+    v = v > 2047 ? 2047 : (v < -2048 ? -2048 : v);
+    out[i] = (int16_t)v;
+  }
+}
+
+// 浮点与 Q15 两条路径并行处理同一序列, 记录频段高度的最大差
+struct Compare {
+  RealFft<float, SAMPLES> fft;
+  FftQ15<SAMPLES> qfft;
+  BandAnalyzer<float, Spectrum> floatBands;
+  BandAnalyzer<float, Spectrum> q15Bands;
+  float maxErr = 0;
+  int frames = 0;
+
+  explicit Compare(const BandParams &p) : floatBands(p), q15Bands(p) {
+  }
+
+  void push(const int16_t *pcm) {
+    float x[SAMPLES];
+    int16_t q[SAMPLES];
+    uint32_t qMag[SAMPLES / 2];
+    float qMagF[SAMPLES / 2];
+    SpectrumFrame<float, 16> ff, qf;
+    uint32_t now = (uint64_t)frames * Spectrum::frameUs / 1000;
+
+    for (int i = 0; i < SAMPLES; i++) {
+      x[i] = pcm[i];
+    }
+    fft.analyze(x);
+    floatBands.process(x, now, ff);
+
+    memcpy(q, pcm, sizeof(q));
+    qfft.analyze(q, qMag);
+    for (int i = 0; i < SAMPLES / 2; i++) {
+      qMagF[i] = qMag[i];
+    }
+    q15Bands.process(qMagF, now, qf);
+
+    for (int i = 0; i < 16; i++) {
+      float err = fabs(ff.bandDb[i] - qf.bandDb[i]);
+      maxErr = err > maxErr ? err : maxErr;
+    }
+    frames++;
+  }
+};
+
+void setUp() {
+  seed = 1;
+}
+
+void tearDown() {
+}
+
+// 依次扫过每个频段的中心频率 (与 native 程序的默认模式相同)
+void sweep_bands(const BandParams &p) {
+  Compare c(p);
+  int16_t pcm[SAMPLES];
+  for (int band = 0; band < 16; band++) {
+    int bin = (Spectrum::binEdges[band] + Spectrum::binEdges[band + 1]) / 2;
+    for (int k = 0; k < 8; k++) {
+      synth(c.frames, bin * Spectrum::hzPerBin, 1200, 20, pcm);
+      c.push(pcm);
+    }
+  }
+  TEST_ASSERT_LESS_OR_EQUAL_FLOAT(TOLERANCE, c.maxErr);
+}
+
+// 随机频率/幅度 (含接近满幅与削顶) 的正弦 + 噪声
+void random_tones(const BandParams &p) {
+  Compare c(p);
+  int16_t pcm[SAMPLES];
+  for (int k = 0; k < 2000; k++) {
+    float freq = 40 + next_rand() % 19600 / 10.0f;
+    float amp = next_rand() % 2200;
+    synth(k, freq, amp, 1 + next_rand() % 64, pcm);
+    c.push(pcm);
+  }
+  TEST_ASSERT_LESS_OR_EQUAL_FLOAT(TOLERANCE, c.maxErr);
+}
+
+void test_band_sweep_oled() {
+  sweep_bands(OLED_PARAMS);
+}
+void test_band_sweep_tft() {
+  sweep_bands(TFT_PARAMS);
+}
+void test_random_tones_oled() {
+  random_tones(OLED_PARAMS);
+}
+void test_random_tones_tft() {
+  random_tones(TFT_PARAMS);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_band_sweep_oled);
+  RUN_TEST(test_band_sweep_tft);
+  RUN_TEST(test_random_tones_oled);
+  RUN_TEST(test_random_tones_tft);
+  return UNITY_END();
+}
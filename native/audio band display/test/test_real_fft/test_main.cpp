@@ -0,0 +1,132 @@
+#include <fft_q15.h>
+#include <math.h>
+#include <real_fft.h>
+#include <unity.h>
+
+/*
+ * RealFft / FftQ15 的幅值与直接计算的 DFT (double, 加 Hamming 窗) 对比
+ *
+ * 输入为 12 位 ADC 量程内的随机正弦 + 噪声, 幅值最大约 7e4 (补零 4 倍时约 1e5).
+ * RealFft<double>: 误差不超过 1e-9;  RealFft<float>: 不超过 0.05 (float 舍入, 约为峰值的 1e-6)
+ * FftQ15: 幅值近似 (约 4%) 与块浮点截断, 每个 bin 不超过 5% + 本帧峰值的 0.2% + 8
+ */
+
+#define FRAMES 500
+
+uint32_t seed;
+
+uint32_t next_rand() {
+  seed = seed * 1103515245 + 12345;
+  return seed >> 8;
+}
+
+void setUp() {
+  seed = 1;
+}
+
+void tearDown() {
+}
+
+// 随机频率 (0~2000Hz @ 4kHz) 与幅度的正弦 + 噪声, 截到 12 位
+template <int W>
+void synth(int16_t *x) {
+  double freq = next_rand() % 20000 / 10.0;
+  double amp = next_rand() % 2048;
+  for (int i = 0; i < W; i++) {
+    double v = amp * sin(2 * M_PI * freq * i / 4000) + (int)(next_rand() % 41) - 20;
+    x[i] = (int16_t)(v > 2047 ? 2047 : (v < -2048 ? -2048 : v));
+  }
+}
+
+// 参考: 前 W 个采样加 Hamming 窗 (arduinoFFT 的对称定义), 补零到 N 点, 直接计算 DFT 的前 N/2 个幅值
+template <int N, int W>
+void reference_dft(const int16_t *x, double *mag) {
+  for (int k = 0; k < N / 2; k++) {
+    double re = 0;
+    double im = 0;
+    for (int i = 0; i < W; i++) {
+      double v = x[i] * (0.54 - 0.46 * cos(2 * M_PI * i / (W - 1)));
+      re += v * cos(2 * M_PI * k * i / N);
+      im -= v * sin(2 * M_PI * k * i / N);
+    }
+    mag[k] = sqrt(re * re + im * im);
+  }
+}
+
+// 所有帧所有 bin 中的最大绝对误差
+template <typename T, int N, int W>
+double real_fft_error() {
+  static RealFft<T, N, W> fft;
+  double maxErr = 0;
+  for (int f = 0; f < FRAMES; f++) {
+    int16_t pcm[W];
+    double ref[N / 2];
+    T x[N];
+    synth<W>(pcm);
+    reference_dft<N, W>(pcm, ref);
+    for (int i = 0; i < W; i++) {
+      x[i] = pcm[i];
+    }
+    fft.analyze(x);
+    for (int k = 0; k < N / 2; k++) {
+      double err = fabs(x[k] - ref[k]);
+      maxErr = err > maxErr ? err : maxErr;
+    }
+  }
+  return maxErr;
+}
+
+void test_real_fft_double() {
+  TEST_ASSERT_DOUBLE_WITHIN(1e-9, 0, (real_fft_error<double, 128, 128>()));
+}
+
+void test_real_fft_float() {
+  TEST_ASSERT_DOUBLE_WITHIN(0.05, 0, (real_fft_error<float, 128, 128>()));
+}
+
+void test_real_fft_zero_padded() {
+  TEST_ASSERT_DOUBLE_WITHIN(1e-9, 0, (real_fft_error<double, 512, 128>()));
+  TEST_ASSERT_DOUBLE_WITHIN(0.05, 0, (real_fft_error<float, 256, 128>()));
+}
+
+// 误差与容限之比的最大值, 不超过 1 即通过
+template <int N, int W>
+double q15_error_ratio() {
+  static FftQ15<N, W> fft;
+  double worst = 0;
+  for (int f = 0; f < FRAMES; f++) {
+    int16_t x[N];
+    double ref[N / 2];
+    uint32_t mag[N / 2];
+    synth<W>(x);
+    reference_dft<N, W>(x, ref);
+    fft.analyze(x, mag);
+    double peak = 0;
+    for (int k = 0; k < N / 2; k++) {
+      peak = ref[k] > peak ? ref[k] : peak;
+    }
+    for (int k = 0; k < N / 2; k++) {
+      double ratio = fabs(mag[k] - ref[k]) / (0.05 * ref[k] + 0.002 * peak + 8);
+      worst = ratio > worst ? ratio : worst;
+    }
+  }
+  return worst;
+}
+
+void test_fft_q15() {
+  TEST_ASSERT_DOUBLE_WITHIN(1.0, 0, (q15_error_ratio<128, 128>()));
+}
+
+void test_fft_q15_zero_padded() {
+  TEST_ASSERT_DOUBLE_WITHIN(1.0, 0, (q15_error_ratio<256, 128>()));
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_real_fft_double);
+  RUN_TEST(test_real_fft_float);
+  RUN_TEST(test_real_fft_zero_padded);
+  RUN_TEST(test_fft_q15);
+  RUN_TEST(test_fft_q15_zero_padded);
+  return UNITY_END();
+}
@@ -1,28 +1,34 @@
 #include "hardware/adc.h"
+#include "hardware/dma.h"
 #include "hardware/gpio.h"
-#include "hardware/spi.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+#include "st7735.h"
 #include <Arduino.h>
-#include <arduinoFFT.h>
+#include <band_analyzer.h>
+#include <fast_db.h>
+#include <fft_q15.h>
+#include <octave_bank.h>
+#include <overlap_buffer.h>
+#include <real_fft.h>
+#include <sliding_dft.h>
+#include <spectrum_bench.h>
+#include <spectrum_config.h>
+#include <stage_profiler.h>
+#include <tft_band_view.h>
 
 /* ================= 硬件引脚定义 ================= */
-#define TFT_SPI spi0 // 使用 SPI0
-#define PIN_SCK 2    // SPI 时钟引脚
-#define PIN_MOSI 3   // SPI 主出从入引脚
-#define PIN_CS 1     // 片选引脚
-#define PIN_DC 5     // 数据/命令引脚
-#define PIN_RST 4    // 复位引脚
 #define MIC_PIN 26   // ADC0 麦克风输入引脚
-
-#define TFT_BAUD 40000000 // SPI 时钟 20/40 MHz
-#define TFT_WIDTH 160     // ST7735 屏幕宽度
-#define TFT_HEIGHT 80     // ST7735 屏幕高度
-#define HEADER_H 12       // 顶部文字高度
+#define HEADER_H 12  // 顶部文字高度
 
 /* ================= 频谱参数 ================= */
 #define BAND_NUM 16        // 频段数量
 #define BLOCK_HIGHT 7      // 垂直方块高度
 #define SAMPLES 128        // FFT采样点数 必须为2的幂
 #define SAMPLING_FREQ 4000 // 采样频率 (Hz)
+#ifndef FFT_Q15
+#define FFT_Q15 0          // 1: 使用 Q15 定点 FFT (Cortex-M0+ 无 FPU, 比 double 快得多)
+#endif
 
 #define noiseFloor 30  // 噪声抑制 越大抑制程度越高
 #define dbMult 8.0     // 放大倍数 越大越灵敏
@@ -30,305 +36,431 @@
 #define smoothUp 0.9   // 上升平滑系数 0~1 越大上升响应越快
 #define smoothDown 0.3 // 下降平滑系数 0~1 越大下降响应越快
 
-double globalMaxDb = 0.0;   // 过去一段时间最大分贝值
-double globalMaxFreq = 0.0; // 过去一段时间最大分贝值对应频率值
-uint16_t peakTimeInterval = 500;    // 峰值更新周期 (ms)
-uint8_t color_offset = 55;  // 颜色偏移 底部绿色 顶部红色
-
-double vReal[SAMPLES];         // FFT 输入数组
-double vImag[SAMPLES];         // FFT 输出数组
-double bandDb[BAND_NUM];       // 当前显示的频谱数据
-double oldBandDb[BAND_NUM];    // 上次显示的频谱数据
-double peakDb[BAND_NUM];       // 频谱顶点数据
-arduinoFFT FFT = arduinoFFT(); // FFT 对象
+#ifndef ANALYSIS_ENGINE
+#define ANALYSIS_ENGINE 0  // 0: 整块 FFT; 1: 滑动 DFT 滤波器组 (每个采样更新, 计算量约为 FFT 的 5 倍)
+                           // 2: 八度滤波器组 (以 OCTAVE_FS 采样, 频段覆盖 62Hz~16kHz)
+#endif
+#define SDFT_HOP 32        // 滑动 DFT 每隔多少个采样输出一帧 (SAMPLES 的约数)
+#define OCTAVE_FS 32000    // 八度滤波器组的采样频率 (Hz, SAMPLING_FREQ 的整数倍), 最高分析到 OCTAVE_FS / 2
+#define OCTAVES 8          // 八度数, 最低频率为 OCTAVE_FS / 2^(OCTAVES + 1); BAND_NUM 须为其整数倍
+#ifndef FFT_OVERLAP
+#define FFT_OVERLAP 0      // 相邻 FFT 窗口的重叠比例 (%): 0 / 50 / 75, 重叠越多帧率越高, FFT 次数也越多
+#endif
+#define FFT_HOP (SAMPLES * (100 - FFT_OVERLAP) / 100) // FFT 每隔多少个新采样输出一帧
+#ifndef PEAK_INTERP
+#define PEAK_INTERP 2      // 顶部频率读数的峰值插值: 0: 取 bin 中心; 1: 抛物线; 2: 对数抛物线 (误差约 0.6Hz)
+#endif
+#ifndef FFT_ZERO_PAD
+#define FFT_ZERO_PAD 1     // FFT 补零倍数 (1/2/4): 峰值频率更准, FFT 计算量随之成倍增加 (仅 ANALYSIS_ENGINE 0)
+#endif
+#define FFT_SIZE (SAMPLES * FFT_ZERO_PAD) // FFT 点数
+
+#if ANALYSIS_ENGINE == 2
+#define AUDIO_RATE OCTAVE_FS // ADC 采样频率
+#else
+#define AUDIO_RATE SAMPLING_FREQ
+#endif
+#define FRAME_SAMPLES (SAMPLES * (AUDIO_RATE / SAMPLING_FREQ)) // SAMPLES / SAMPLING_FREQ 时长内的采样数
+
+#if ANALYSIS_ENGINE == 2
+#define AUDIO_CHUNK (FRAME_SAMPLES / 4) // DMA 每次采满的采样数 (八度滤波器组每 4 块输出一帧)
+#define FRAME_HOP SAMPLES   // 相邻两帧之间的时长 (按 SAMPLING_FREQ 的采样数计)
+#elif ANALYSIS_ENGINE == 1
+#define AUDIO_CHUNK SAMPLES // DMA 每次采满的采样数 (滑动 DFT 在一块内逐 hop 输出)
+#define FRAME_HOP SDFT_HOP  // 相邻两帧之间的新采样数
+#else
+#define AUDIO_CHUNK FFT_HOP
+#define FRAME_HOP FFT_HOP
+#endif
+
+#ifndef DUAL_CORE
+#define DUAL_CORE 1    // 1: core1 采样+FFT, core0 只负责绘制; 0: 单核串行
+#endif
+#define FRAME_RING 4   // 双核之间的频谱帧环形队列长度 (2 的幂)
+#ifndef SPECTRUM_BENCH
+#define SPECTRUM_BENCH 0 // 1: 启动时打印热点路径微基准 (CPU 周期/帧)
+#endif
+#ifndef STAGE_PROFILE
+#define STAGE_PROFILE 0  // 1: 统计各阶段耗时, 随每秒帧率统计打印 min/avg/p99/max (us); 0: 完全不参与编译
+#endif
 
-int bin_indices[17] = { // 频段对应的 FFT bin 索引
-    2, 3, 4, 5, 7, 9, 11, 13, 16, 19, 23, 28, 34, 41, 49, 58, 64};
+uint8_t color_offset = 55;  // 颜色偏移 底部绿色 顶部红色
 
-/* ================= ST7735 驱动底层 ================= */
-// 设置引脚电平状态
-inline void tft_dc(bool level) {
-  gpio_put(PIN_DC, level);
-}
-// 片选引脚
-inline void tft_cs(bool level) {
-  gpio_put(PIN_CS, level);
-}
-// 复位引脚
-inline void tft_rst(bool level) {
-  gpio_put(PIN_RST, level);
-}
-// 发送命令和数据
-void tft_write_cmd(uint8_t cmd) {
-  tft_dc(0);
-  tft_cs(0);
-  spi_write_blocking(TFT_SPI, &cmd, 1);
-  tft_cs(1);
-}
-// 发送数据
-void tft_write_data(uint8_t data) {
-  tft_dc(1);
-  tft_cs(0);
-  spi_write_blocking(TFT_SPI, &data, 1);
-  tft_cs(1);
-}
-// 设置绘图窗口
-void tft_set_addr_window(int x1, int y1, int x2, int y2) {
-  // 针对 160x80 偏移处理 (通常 ST7735 160x80 需要偏移)
-  // x1 += 1;
-  // x2 += 1;
-  y1 += 24;
-  y2 += 24;
-
-  tft_write_cmd(0x2A); // Column Address Set
-  tft_write_data(x1 >> 8);
-  tft_write_data(x1 & 0xFF);
-  tft_write_data(x2 >> 8);
-  tft_write_data(x2 & 0xFF);
-
-  tft_write_cmd(0x2B); // Row Address Set
-  tft_write_data(y1 >> 8);
-  tft_write_data(y1 & 0xFF);
-  tft_write_data(y2 >> 8);
-  tft_write_data(y2 & 0xFF);
-
-  tft_write_cmd(0x2C); // Memory Write
+double vReal[FFT_SIZE];        // FFT 输入数组
+#if FFT_Q15
+int16_t qReal[FFT_SIZE];       // 定点 FFT 输入/打包频谱
+uint32_t qMag[FFT_SIZE / 2];   // 定点 FFT 幅值输出
+FftQ15<FFT_SIZE, SAMPLES> qFFT; // 定点 FFT 对象 (前 SAMPLES 点加窗, 其余补零)
+#else
+RealFft<double, FFT_SIZE, SAMPLES> FFT; // 实数 FFT 对象
+#endif
+
+uint16_t adcBuf[2][AUDIO_CHUNK];   // ADC DMA 乒乓缓冲
+int adcDmaChan[2];                 // 两个互相链接的 DMA 通道
+volatile uint32_t adcFrameSeq = 0; // 已采满的帧计数 (第 n 块在 adcBuf[(n - 1) & 1] 中)
+volatile uint32_t lostChunks = 0;  // 来不及取走就被跳过的采样块数 (不清零)
+
+// 频段边界表与 bin 频率宽度由编译期生成, 修改上面的宏即可
+typedef SpectrumConfig<SAMPLES, SAMPLING_FREQ, BAND_NUM, 2, FFT_ZERO_PAD> Spectrum;
+// 频段平滑与峰值下坠 (按 FRAME_HOP 换算, 帧率变化时按实际时间计的速度不变)
+BandAnalyzer<double, Spectrum> bands({noiseFloor, dbMult, peakFall, smoothUp, smoothDown}, 500, FRAME_HOP,
+                                     (PeakInterp)PEAK_INTERP);
+OverlapBuffer<int16_t, SAMPLES> sample_window; // 最近 SAMPLES 个采样, 重叠分帧时每次只更新 FFT_HOP 个
+int window_fill = 0; // sample_window 中连续采样的个数, 未满 SAMPLES 时不输出频谱帧
+
+/* ================= 分阶段耗时 ================= */
+// 滤波器组模式下 fft 为逐采样更新/抽取, magnitude 为读出各频段幅值
+// core1 只写采样~频段计算, core0 只写绘制与刷屏, 每个阶段只有一个写入方
+enum ProfStage { PROF_CAPTURE, PROF_WINDOW, PROF_FFT, PROF_MAGNITUDE, PROF_BANDS, PROF_RENDER, PROF_FLUSH, PROF_COUNT };
+
+#if STAGE_PROFILE
+const char *prof_names[PROF_COUNT] = {"capture", "window", "fft", "magnitude", "bands", "render", "flush"};
+StageProfiler<PROF_COUNT> profiler; // 单位: CPU 周期 (M0+ 没有 DWT, 用 SysTick 计数)
+
+// PROF_START 开始计时, PROF_LAP 记录从上次计时点到现在的耗时并重新开始
+#define PROF_START(t) uint32_t t = rp2040.getCycleCount()
+#define PROF_LAP(stage, t)                      \
+  do {                                          \
+    uint32_t now_ = rp2040.getCycleCount();     \
+    profiler.record(stage, now_ - (t));         \
+    t = now_;                                   \
+  } while (0)
+
+// 打印各阶段本周期的统计并开始新周期
+void print_profile() {
+  float mhz = rp2040.f_cpu() / 1e6f;
+  for (int i = 0; i < PROF_COUNT; i++) {
+    StageSummary s = profiler.summary(i);
+    Serial.printf("  %-9s n %4u  min %7.1f  avg %7.1f  p99 %7.1f  max %7.1f us\n", prof_names[i], s.count,
+                  s.min / mhz, s.avg / mhz, s.p99 / mhz, s.max / mhz);
+  }
+  profiler.request_reset();
 }
-// 初始化 TFT 屏幕
-void tft_init() {
-  tft_rst(1);
-  delay(10);
-
-  tft_rst(0);
-  delay(10);
-
-  tft_rst(1);
-  delay(100);
-
-  tft_write_cmd(0x01);
-  delay(150); // Software reset
-
-  tft_write_cmd(0x11);
-  delay(150); // Sleep out
-
-  tft_write_cmd(0x3A);
-  tft_write_data(0x05); // 16-bit color
-
-  tft_write_cmd(0x36);
-  // tft_write_data(0xA8); // 横屏
-  // tft_write_data(0x00); // 竖屏
-  tft_write_data(0x60); // 横屏翻转
-
-  // tft_write_cmd(0x21); // 颜色反转
-  tft_write_cmd(0x29); // Display ON
+#else
+#define PROF_START(t)
+#define PROF_LAP(stage, t) \
+  do {                     \
+  } while (0)
+#endif
+
+// ADC DMA 完成中断: 重置刚写满通道的写地址, 并标记该缓冲可读
+void adc_dma_irq() {
+  for (int k = 0; k < 2; k++) {
+    uint32_t mask = 1u << adcDmaChan[k];
+    if (dma_hw->ints0 & mask) {
+      dma_hw->ints0 = mask;
+      dma_channel_set_write_addr(adcDmaChan[k], adcBuf[k], false);
+      adcFrameSeq++;
+    }
+  }
 }
-// 填充矩形区域
-void tft_fill_rect(int x, int y, int w, int h, uint16_t color) {
-  if (x >= TFT_WIDTH || y >= TFT_HEIGHT)
-    return;
-  if (x + w > TFT_WIDTH)
-    w = TFT_WIDTH - x;
-  if (y + h > TFT_HEIGHT)
-    h = TFT_HEIGHT - y;
-  if (w <= 0 || h <= 0)
-    return;
-
-  tft_set_addr_window(x, y, x + w - 1, y + h - 1);
-  uint8_t data[2] = {(uint8_t)(color >> 8), (uint8_t)(color & 0xFF)};
-
-  tft_dc(1);
-  tft_cs(0);
-  for (int i = 0; i < w * h; i++) {
-    spi_write_blocking(TFT_SPI, data, 2);
+// 初始化 ADC 自由运行采样: 由 ADC 时钟分频定时, DMA 乒乓搬运 FIFO
+void adc_dma_init() {
+  adc_fifo_setup(true, true, 1, false, false); // 开启 FIFO 与 DREQ, 保留 12 位结果
+  adc_set_clkdiv(48000000.0f / AUDIO_RATE - 1); // ADC 时钟 48MHz
+
+  adcDmaChan[0] = dma_claim_unused_channel(true);
+  adcDmaChan[1] = dma_claim_unused_channel(true);
+  for (int k = 0; k < 2; k++) {
+    dma_channel_config cfg = dma_channel_get_default_config(adcDmaChan[k]);
+    channel_config_set_transfer_data_size(&cfg, DMA_SIZE_16);
+    channel_config_set_read_increment(&cfg, false);
+    channel_config_set_write_increment(&cfg, true);
+    channel_config_set_dreq(&cfg, DREQ_ADC);
+    channel_config_set_chain_to(&cfg, adcDmaChan[k ^ 1]); // 写满后自动切换到另一个缓冲
+    dma_channel_configure(adcDmaChan[k], &cfg, adcBuf[k], &adc_hw->fifo, AUDIO_CHUNK, false);
+    dma_channel_set_irq0_enabled(adcDmaChan[k], true);
   }
-  tft_cs(1);
+  irq_add_shared_handler(DMA_IRQ_0, adc_dma_irq, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+  irq_set_enabled(DMA_IRQ_0, true);
+
+  dma_channel_start(adcDmaChan[0]);
+  adc_run(true);
 }
-// 填充全屏
-void tft_fill_screen(uint16_t color) {
-  tft_fill_rect(0, 0, TFT_WIDTH, TFT_HEIGHT, color);
+#if ANALYSIS_ENGINE == 2
+static_assert(BAND_NUM % OCTAVES == 0, "BAND_NUM 须为 OCTAVES 的整数倍");
+OctaveBank<float, OCTAVE_FS, OCTAVES, BAND_NUM / OCTAVES> octaveBank; // 逐级半带抽取 + 每级 32 点 FFT
+int octave_pending = 0; // 距上一帧已送入的采样数
+#elif ANALYSIS_ENGINE == 1
+SlidingDftBank<float, Spectrum> sdftBank; // 每个频段一个滑动 DFT 滤波器 (float 比 double 快)
+#endif
+
+// 采样不连续时 (计算或绘制太慢, 取走这一块之前 DMA 已采满不止一块) 清除跨块的状态,
+// 避免把前后两段无关的音频拼进同一个 FFT 窗口或滤波器 (频段平滑与峰值下坠不受影响, 显示照常衰减)
+void reset_stream() {
+#if ANALYSIS_ENGINE == 1
+  sdftBank.reset();
+#elif ANALYSIS_ENGINE == 2
+  octaveBank.reset();
+  octave_pending = 0;
+#else
+  sample_window.reset();
+  window_fill = 0;
+#endif
 }
 
-// 颜色轮转换函数 (输入0-255 输出RGB565颜色)
-uint16_t wheel(uint8_t pos) {
-  pos = 255 - pos;
-  if (pos < 85) {
-    // RGB565 approximation
-    return (((255 - pos * 3) & 0xF8) << 8) | ((pos * 3 >> 2) << 5) | (0);
+// 音频采样函数 (等待 DMA 采满新的一块, 计算期间下一块在后台继续采集)
+// FFT: 新采样并入窗口, 取出最近 SAMPLES 个; 滑动 DFT: 直接取出这一块; 八度: 送入滤波器组
+// 窗口中的连续采样不足 SAMPLES 个时 (启动或丢块后) 返回 false, 本块不输出频谱
+bool sampleAudio() {
+  static uint32_t lastSeq = 0;
+  while (adcFrameSeq == lastSeq) {
+    tight_loop_contents();
   }
-  if (pos < 170) {
-    pos -= 85;
-    return (0 << 11) | (((pos * 3) >> 2) << 5) | ((255 - pos * 3) >> 3);
+  uint32_t seq = adcFrameSeq;
+  if (seq - lastSeq > 1) {
+    lostChunks += seq - lastSeq - 1;
+    reset_stream();
   }
-  pos -= 170;
-  return (((pos * 3) & 0xF8) << 8) | (((255 - pos * 3) >> 2) << 5) | 0;
-}
-// 音频采样函数
-void sampleAudio() {
-  unsigned long start = micros();
+  lastSeq = seq;
+  PROF_START(t);
+
+  // 按序号取缓冲: 读序号之后中断再次到来也不会取到更新的一块
+  const uint16_t *buf = adcBuf[(seq - 1) & 1];
+#if ANALYSIS_ENGINE == 2
+  static float in[AUDIO_CHUNK];
+  for (int i = 0; i < AUDIO_CHUNK; i++) {
+    in[i] = buf[i] - 2048.0f;
+  }
+  PROF_LAP(PROF_CAPTURE, t);
+  octaveBank.push(in, AUDIO_CHUNK);
+  PROF_LAP(PROF_FFT, t);
+#elif ANALYSIS_ENGINE == 1
   for (int i = 0; i < SAMPLES; i++) {
-    vReal[i] = adc_read() - 2048.0;
-    vImag[i] = 0;
-    while (micros() - start < 250);
-    start += 250;
+    vReal[i] = buf[i] - 2048.0;
+  }
+#else
+  sample_window.push(buf, AUDIO_CHUNK, -2048);
+  if (window_fill < SAMPLES) {
+    window_fill += AUDIO_CHUNK;
+  }
+  if (window_fill < SAMPLES) {
+    PROF_LAP(PROF_CAPTURE, t);
+    return false;
   }
+#if FFT_Q15
+  sample_window.copy_to(qReal);
+#else
+  sample_window.copy_to(vReal);
+#endif
+#endif
+#if ANALYSIS_ENGINE != 2
+  PROF_LAP(PROF_CAPTURE, t);
+#endif
+  return true;
 }
 // 计算频段函数
 void calc_band() {
-  FFT.Windowing(vReal, SAMPLES, FFT_WIN_TYP_HAMMING, FFT_FORWARD);
-  FFT.Compute(vReal, vImag, SAMPLES, FFT_FORWARD);
-  FFT.ComplexToMagnitude(vReal, vImag, SAMPLES);
+  PROF_START(t);
+#if FFT_Q15
+  int32_t peak = qFFT.window(qReal);
+  PROF_LAP(PROF_WINDOW, t);
+  int shifts = qFFT.compute(qReal, peak);
+  PROF_LAP(PROF_FFT, t);
+  qFFT.magnitude(qReal, qMag, shifts);
+  for (int i = 0; i < FFT_SIZE / 2; i++) {
+    vReal[i] = qMag[i];
+  }
+#else
+  FFT.window(vReal);
+  PROF_LAP(PROF_WINDOW, t);
+  FFT.compute(vReal);
+  PROF_LAP(PROF_FFT, t);
+  FFT.magnitude(vReal);
+#endif
+  PROF_LAP(PROF_MAGNITUDE, t);
 }
 
-// 简易 5x7 字体点阵 (部分常用字符: 0-9, A-Z, '.', ' ', 'd', 'B', 'H', 'z')
-const uint8_t font5x7[][5] = {
-    {0x3E, 0x51, 0x49, 0x45, 0x3E}, // 0
-    {0x00, 0x42, 0x7F, 0x40, 0x00}, // 1
-    {0x42, 0x61, 0x51, 0x49, 0x46}, // 2
-    {0x21, 0x41, 0x45, 0x4B, 0x31}, // 3
-    {0x18, 0x14, 0x12, 0x7F, 0x10}, // 4
-    {0x27, 0x45, 0x45, 0x45, 0x39}, // 5
-    {0x3C, 0x4A, 0x49, 0x49, 0x30}, // 6
-    {0x01, 0x71, 0x09, 0x05, 0x03}, // 7
-    {0x36, 0x49, 0x49, 0x49, 0x36}, // 8
-    {0x06, 0x49, 0x49, 0x29, 0x1E}, // 9
-    {0x00, 0x60, 0x60, 0x00, 0x00}, // .
-    {0x00, 0x00, 0x00, 0x00, 0x00}, // space
-    {0x7E, 0x11, 0x11, 0x11, 0x7E}, // A
-    {0x7F, 0x49, 0x49, 0x49, 0x36}, // B
-    {0x38, 0x44, 0x44, 0x44, 0x7F}, // d
-    {0x7F, 0x09, 0x09, 0x09, 0x01}, // F
-    {0x7F, 0x08, 0x08, 0x08, 0x7F}, // H
-    {0x44, 0x7D, 0x40, 0x00, 0x00}, // i
-    {0x44, 0x64, 0x54, 0x4C, 0x44}, // z
-};
+// 一帧待显示的频谱数据
+typedef SpectrumFrame<double, BAND_NUM> BandFrame;
 
-// 字符绘制函数
-void tft_draw_char(int x, int y, char c, uint16_t color) {
-  int idx = -1;
-  if (c >= '0' && c <= '9')
-    idx = c - '0';
-  else if (c == '.')
-    idx = 10;
-  else if (c == ' ')
-    idx = 11;
-  else if (c == 'A')
-    idx = 12;
-  else if (c == 'B')
-    idx = 13;
-  else if (c == 'd')
-    idx = 14;
-  else if (c == 'F')
-    idx = 15;
-  else if (c == 'H')
-    idx = 16;
-  else if (c == 'i')
-    idx = 17;
-  else if (c == 'z')
-    idx = 18;
-  if (idx == -1)
-    return;
+// 频段计算函数 (平滑与峰值下坠状态保存在 bands 中)
+void update_bands(BandFrame &f) {
+  PROF_START(t);
+  bands.process(vReal, millis(), f);
+  PROF_LAP(PROF_BANDS, t);
+}
 
-  for (int i = 0; i < 5; i++) {
-    uint8_t line = font5x7[idx][i];
-    for (int j = 0; j < 7; j++) {
-      if (line & (1 << j)) {
-        tft_fill_rect(x + i, y + j, 1, 1, color);
-      }
-    }
+#if ANALYSIS_ENGINE == 1
+// 把 vReal[offset..offset+SDFT_HOP) 逐个送入滤波器组
+void push_hop(int offset) {
+  PROF_START(t);
+  for (int i = offset; i < offset + SDFT_HOP; i++) {
+    sdftBank.push(vReal[i]);
   }
+  PROF_LAP(PROF_FFT, t);
 }
-// 字符串绘制函数
-void tft_draw_string(int x, int y, const char *s, uint16_t color) {
-  while (*s) {
-    tft_draw_char(x, y, *s++, color);
-    x += 6;
+
+#endif
+
+#if ANALYSIS_ENGINE != 0
+// 读出滤波器组各频段幅值并计算显示数据
+void update_bands_bank(BandFrame &f) {
+  PROF_START(t);
+  float amp[BAND_NUM];
+  float peakFreq;
+#if ANALYSIS_ENGINE == 2
+  float frameMax = octaveBank.magnitudes(amp, peakFreq);
+#else
+  float frameMax = sdftBank.magnitudes(amp, peakFreq);
+#endif
+  double bandAmp[BAND_NUM];
+  for (int i = 0; i < BAND_NUM; i++) {
+    bandAmp[i] = amp[i];
   }
+  PROF_LAP(PROF_MAGNITUDE, t);
+  bands.update(bandAmp, frameMax, peakFreq, millis(), f);
+  PROF_LAP(PROF_BANDS, t);
 }
+#endif
 
-unsigned long lastPeakUpdate = 0;
-
-// 计算方块高度
-int usableHeight = TFT_HEIGHT - HEADER_H;
-
-// 频谱绘制函数
-void draw_spectrum() {
-  // 1. 查找当前帧最大值及其对应频率
-  double frameMax = 0;
-  int frameBin = 0;
-  for (int i = 4; i < SAMPLES / 2; i ++) {
-    if (vReal[i] > frameMax) {
-      frameMax = vReal[i];
-      frameBin = i;
-    }
+// 频谱画面 (布局与增量绘制在 lib/spectrum/tft_band_view.h, 主机模拟器共用)
+struct TftDisplay {
+  void fill_rect(int x, int y, int w, int h, uint16_t color) {
+    tft_fill_rect(x, y, w, h, color);
   }
-
-  unsigned long now = millis();
-  if (now - lastPeakUpdate > peakTimeInterval) {
-    globalMaxDb = 20 * log10(frameMax + 1);
-    globalMaxFreq = frameBin * (SAMPLING_FREQ / SAMPLES);
-    lastPeakUpdate = now;
-    // color_offset += 5; // 动态颜色滚动
+  void draw_string(int x, int y, const char *s, uint16_t color) {
+    tft_draw_string(x, y, s, color);
   }
+};
+TftDisplay tft;
+TftBandView<TftDisplay, BAND_NUM, TFT_WIDTH, TFT_HEIGHT, HEADER_H, BLOCK_HIGHT> band_view(color_offset);
 
-  // 2. 绘制顶部文字区域
-  tft_fill_rect(0, 0, TFT_WIDTH, HEADER_H, 0x0000);
-  char buf[20];
-  sprintf(buf, "%4.1f dB", globalMaxDb);
-  tft_draw_string(5, 2, buf, 0xFFFF);
-  sprintf(buf, "%4d Hz", (int)globalMaxFreq);
-  tft_draw_string(90, 2, buf, 0xFFFF);
+// 频谱绘制函数 (只绘制与上一帧不同的部分)
+void draw_spectrum(const BandFrame &f) {
+  band_view.draw(tft, f);
+}
 
-  // 3. 绘制频谱条与峰值线
-  int barWidth = TFT_WIDTH / BAND_NUM;
-  for (int i = 0; i < BAND_NUM; i++) {
-    double maxAmp = 0;
-    for (int j = bin_indices[i]; j < bin_indices[i + 1]; j++) {
-      if (vReal[j] > maxAmp)
-        maxAmp = vReal[j];
-    }
+/* ================= 帧率统计 ================= */
+unsigned long statStart = 0;    // 本统计周期开始时间 (ms)
+unsigned long lastFrameUs = 0;  // 上一帧完成时间 (us)
+unsigned long slowestUs = 0;    // 本周期最慢一帧耗时 (us)
+unsigned long renderUs = 0;     // 本周期绘制+刷屏累计耗时 (us)
+uint32_t statFrames = 0;        // 本周期绘制帧数
+uint32_t statSpiBytes = 0;      // 本周期开始时的 SPI 字节计数
+uint32_t statDmaWaitUs = 0;     // 本周期开始时的 DMA 等待计时
+volatile uint32_t droppedFrames = 0; // 队列满时丢弃的帧数
+
+// 绘制并刷新一帧, 统计绘制耗时 (开启 DMA 时刷新在后台进行, 不计入)
+void render_frame(const BandFrame &f) {
+  unsigned long t0 = micros();
+  PROF_START(t);
+  draw_spectrum(f);
+  PROF_LAP(PROF_RENDER, t);
+  tft_flush();
+  PROF_LAP(PROF_FLUSH, t);
+  renderUs += micros() - t0;
+}
 
-    // 计算当前分贝并平滑
-    double norm = constrain((maxAmp - noiseFloor) / 2048.0 * dbMult, 0, 1);
-    double db = norm * 100;
-    if (db > oldBandDb[i]) {
-      // 上升
-      bandDb[i] = db * smoothUp + oldBandDb[i] * (1 - smoothUp);
-    } else {
-      // 下降
-      bandDb[i] = db * smoothDown + oldBandDb[i] * (1 - smoothDown);
-    }
-    oldBandDb[i] = bandDb[i];
+// 每帧绘制完成后调用, 每秒输出一次帧率、最慢帧耗时以及每帧 SPI 字节数、绘制耗时与等待 DMA 的时间
+void frame_stats() {
+  unsigned long nowUs = micros();
+  if (lastFrameUs != 0 && nowUs - lastFrameUs > slowestUs) {
+    slowestUs = nowUs - lastFrameUs;
+  }
+  lastFrameUs = nowUs;
+  statFrames++;
 
-    // 局部清空该列
-    tft_fill_rect(i * barWidth, HEADER_H, barWidth - 1, usableHeight, 0x0000);
-    int totalPx = map(bandDb[i], 0, 100, 0, usableHeight - 4);
-    int numBlocks = totalPx / BLOCK_HIGHT;
+  unsigned long now = millis();
+  if (now - statStart >= 1000) {
+    // dropped: 绘制跟不上而丢弃的频谱帧; lost: 来不及取走而丢失的采样块 (均为累计值, lost 持续增长说明计算跟不上采集)
+    Serial.printf("%s fps=%.1f slowest=%.1fms dropped=%lu lost=%lu spi=%luB/frame render=%.2fms dmaWait=%.2fms fb=%d dma=%d\n",
+                  DUAL_CORE ? "dual" : "serial",
+                  statFrames * 1000.0 / (now - statStart), slowestUs / 1000.0,
+                  (unsigned long)droppedFrames, (unsigned long)lostChunks,
+                  (unsigned long)((tftSpiBytes - statSpiBytes) / statFrames),
+                  renderUs / 1000.0 / statFrames, (tftDmaWaitUs - statDmaWaitUs) / 1000.0 / statFrames,
+                  TFT_FRAMEBUFFER, TFT_DMA);
+#if STAGE_PROFILE
+    print_profile();
+#endif
+    statStart = now;
+    statFrames = 0;
+    slowestUs = 0;
+    renderUs = 0;
+    statSpiBytes = tftSpiBytes;
+    statDmaWaitUs = tftDmaWaitUs;
+  }
+}
 
-    // 绘制彩色方块
-    for (int b = 0; b < numBlocks; b++) {
-      uint16_t c = wheel(b * BLOCK_HIGHT * 2 + color_offset);
-      tft_fill_rect(i * barWidth, TFT_HEIGHT - (b + 1) * BLOCK_HIGHT, barWidth - 2, BLOCK_HIGHT - 2, c);
-    }
+// 初始化麦克风 ADC 与 DMA 采样 (由负责采样的核调用, DMA 中断落在该核上)
+void audio_init() {
+  adc_init();
+  adc_gpio_init(MIC_PIN);
+  adc_select_input(0); // GP26 is ADC0
+  adc_dma_init();
+}
 
-    // 4. 峰值线逻辑 (下坠)
-    if (bandDb[i] > peakDb[i]) {
-      peakDb[i] = bandDb[i];
-    } else {
-      peakDb[i] -= peakFall;
-    }
+#if DUAL_CORE
+/* ================= 双核流水线 ================= */
+// core1 生产, core0 消费的单生产者单消费者环形队列
+// (多核 FIFO 被 arduino-pico 用于暂停另一核, 这里不占用)
+BandFrame frameRing[FRAME_RING];
+volatile uint32_t ringHead = 0; // 仅 core1 写
+volatile uint32_t ringTail = 0; // 仅 core0 写
+BandFrame analysis_frame;       // core1 每帧的计算结果 (丢帧时平滑与峰值下坠也照常推进)
+
+// 发布 analysis_frame, 绘制跟不上时只丢弃这一帧的显示
+void publish_frame() {
+  uint32_t head = ringHead;
+  if (head - ringTail >= FRAME_RING) {
+    droppedFrames++;
+    return;
+  }
+  frameRing[head & (FRAME_RING - 1)] = analysis_frame;
+  __dmb(); // 帧数据写完后再发布
+  ringHead = head + 1;
+}
 
-    // 映射峰值 Y 坐标
-    int peakY = map(peakDb[i], 0, 100, TFT_HEIGHT, HEADER_H + 1);
-    peakY = constrain(peakY, HEADER_H + 1, TFT_HEIGHT - 1);
+void setup1() {
+  audio_init();
+}
 
-    // 绘制白色顶点线
-    tft_fill_rect(i * barWidth, peakY, barWidth - 2, 1, 0xFFFF);
+// core1: 采样 + FFT (或滤波器组) + 频段计算
+void loop1() {
+  if (!sampleAudio()) {
+    return;
+  }
+#if ANALYSIS_ENGINE == 1
+  // 滑动 DFT: 每 SDFT_HOP 个采样计算并发布一帧
+  for (int i = 0; i < SAMPLES; i += SDFT_HOP) {
+    push_hop(i);
+    update_bands_bank(analysis_frame);
+    publish_frame();
+  }
+#elif ANALYSIS_ENGINE == 2
+  // 八度滤波器组: 采样已在 sampleAudio 中送入, 每 FRAME_SAMPLES 个采样发布一帧
+  octave_pending += AUDIO_CHUNK;
+  if (octave_pending < FRAME_SAMPLES) {
+    return;
   }
+  octave_pending = 0;
+  update_bands_bank(analysis_frame);
+  publish_frame();
+#else
+  calc_band();
+  update_bands(analysis_frame);
+  publish_frame();
+#endif
 }
+#endif
 
 void setup() {
   Serial.begin(115200);
 
+#if SPECTRUM_BENCH
+  delay(2000); // 等待 USB 串口连接
+  HotPathBench b = run_hotpath_bench<double, BAND_NUM, TFT_HEIGHT - HEADER_H - 4, BLOCK_HIGHT, HEADER_H + 1, TFT_HEIGHT>(
+      [] { return (uint32_t)rp2040.getCycleCount(); });
+  Serial.printf("hot path cycles/frame: log10+map %u  fast_db+LUT %u  mismatches %d\n", b.referencePerFrame,
+                b.fastPerFrame, b.mismatches);
+  EngineBench e = run_engine_bench<float, Spectrum>([] { return (uint32_t)rp2040.getCycleCount(); }, SDFT_HOP);
+  Serial.printf("engine cycles/%d samples: fft %u  sdft %u\n", SAMPLES, e.fftPerBlock, e.sdftPerBlock);
+  uint32_t oct = run_octave_bench<float, Spectrum, OctaveBank<float, OCTAVE_FS, OCTAVES, BAND_NUM / OCTAVES>>(
+      [] { return (uint32_t)rp2040.getCycleCount(); });
+  Serial.printf("octave bank cycles/frame (%dHz, %d bands): %u\n", OCTAVE_FS, BAND_NUM, oct);
+#endif
+
   // 初始化 SPI
   spi_init(TFT_SPI, TFT_BAUD);
   gpio_set_function(PIN_SCK, GPIO_FUNC_SPI);
@@ -342,20 +474,54 @@ void setup() {
   gpio_init(PIN_RST);
   gpio_set_dir(PIN_RST, GPIO_OUT);
 
+#if !DUAL_CORE
   // 初始化 ADC
-  adc_init();
-  adc_gpio_init(MIC_PIN);
-  adc_select_input(0); // GP26 is ADC0
+  audio_init();
+#endif
 
   tft_init();
   tft_fill_screen(0x0000);
+  tft_flush();
 }
 
 void loop() {
-  // 采样音频
-  sampleAudio();
+#if DUAL_CORE
+  // core0: 只绘制最新一帧
+  uint32_t head = ringHead;
+  if (head == ringTail) {
+    return;
+  }
+  __dmb();
+  render_frame(frameRing[(head - 1) & (FRAME_RING - 1)]);
+  ringTail = head;
+#else
+  static BandFrame frame;
+  // 采样音频 (窗口未满时不计算也不绘制)
+  if (!sampleAudio()) {
+    return;
+  }
+#if ANALYSIS_ENGINE == 1
+  // 滑动 DFT 逐段更新, 单核模式下只绘制最后一段的结果
+  for (int i = 0; i < SAMPLES; i += SDFT_HOP) {
+    push_hop(i);
+  }
+  update_bands_bank(frame);
+#elif ANALYSIS_ENGINE == 2
+  // 八度滤波器组: 凑满一帧的采样再计算与绘制
+  octave_pending += AUDIO_CHUNK;
+  if (octave_pending < FRAME_SAMPLES) {
+    return;
+  }
+  octave_pending = 0;
+  update_bands_bank(frame);
+#else
   // FFT 计算
   calc_band();
+  // 频段计算
+  update_bands(frame);
+#endif
   // 绘制频谱
-  draw_spectrum();
-}
\ No newline at end of file
+  render_frame(frame);
+#endif
+  frame_stats();
+}
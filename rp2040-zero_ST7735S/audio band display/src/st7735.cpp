@@ -0,0 +1,466 @@
+#include "st7735.h"
+#include "hardware/dma.h"
+#include "hardware/gpio.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+
+uint32_t tftSpiBytes = 0;
+uint32_t tftDmaWaitUs = 0;
+
+/* ================= ST7735 驱动底层 ================= */
+// 设置引脚电平状态
+inline void tft_dc(bool level) {
+  gpio_put(PIN_DC, level);
+}
+// 片选引脚
+inline void tft_cs(bool level) {
+  gpio_put(PIN_CS, level);
+}
+// 复位引脚
+inline void tft_rst(bool level) {
+  gpio_put(PIN_RST, level);
+}
+// SPI 发送并统计字节数
+inline void tft_spi_write(const uint8_t *data, size_t len) {
+  spi_write_blocking(TFT_SPI, data, len);
+  tftSpiBytes += len;
+}
+// 发送命令和数据
+void tft_write_cmd_raw(uint8_t cmd) {
+  tft_dc(0);
+  tft_cs(0);
+  tft_spi_write(&cmd, 1);
+  tft_cs(1);
+}
+// 发送数据
+void tft_write_data_raw(uint8_t data) {
+  tft_dc(1);
+  tft_cs(0);
+  tft_spi_write(&data, 1);
+  tft_cs(1);
+}
+// 设置绘图窗口 (不等待 DMA, 供 DMA 中断内部使用)
+void tft_set_addr_window_raw(int x1, int y1, int x2, int y2) {
+  // 针对 160x80 偏移处理 (通常 ST7735 160x80 需要偏移)
+  // x1 += 1;
+  // x2 += 1;
+  y1 += 24;
+  y2 += 24;
+
+  tft_write_cmd_raw(0x2A); // Column Address Set
+  tft_write_data_raw(x1 >> 8);
+  tft_write_data_raw(x1 & 0xFF);
+  tft_write_data_raw(x2 >> 8);
+  tft_write_data_raw(x2 & 0xFF);
+
+  tft_write_cmd_raw(0x2B); // Row Address Set
+  tft_write_data_raw(y1 >> 8);
+  tft_write_data_raw(y1 & 0xFF);
+  tft_write_data_raw(y2 >> 8);
+  tft_write_data_raw(y2 & 0xFF);
+
+  tft_write_cmd_raw(0x2C); // Memory Write
+}
+void tft_write_cmd(uint8_t cmd) {
+  tft_dma_wait();
+  tft_write_cmd_raw(cmd);
+}
+void tft_write_data(uint8_t data) {
+  tft_dma_wait();
+  tft_write_data_raw(data);
+}
+void tft_set_addr_window(int x1, int y1, int x2, int y2) {
+  tft_dma_wait();
+  tft_set_addr_window_raw(x1, y1, x2, y2);
+}
+// 阻塞填充 (参数已裁剪)
+void tft_fill_rect_blocking(int x, int y, int w, int h, uint16_t color) {
+  tft_set_addr_window(x, y, x + w - 1, y + h - 1);
+  uint8_t data[2] = {(uint8_t)(color >> 8), (uint8_t)(color & 0xFF)};
+
+  tft_dc(1);
+  tft_cs(0);
+  for (int i = 0; i < w * h; i++) {
+    tft_spi_write(data, 2);
+  }
+  tft_cs(1);
+}
+
+#if TFT_DMA
+/* ================= DMA 异步传输 ================= */
+// 一次传输任务: 纯色填充或像素块
+struct TftJob {
+  int16_t x, y, w, h;  // 目标窗口
+  const uint16_t *src; // 像素数据 (高字节在前), 为空表示纯色填充
+  int16_t stride;      // 源数据每行像素数
+  uint16_t color;      // 纯色填充颜色, DMA 直接读取该字段
+};
+TftJob tftJobs[TFT_JOB_MAX];
+volatile uint32_t jobHead = 0;       // 仅主程序写
+volatile uint32_t jobTail = 0;       // 仅 DMA 中断写
+volatile bool tftDmaActive = false;  // 是否有传输正在进行
+int tftDmaChan = -1;
+int jobRow = 0;                      // 当前像素块已提交的行数
+void (*tftDmaDone)() = nullptr;
+
+// 开始一个任务: 设置窗口后交给 DMA, 中断关闭或在 DMA 中断中调用
+void tft_job_start(TftJob &j) {
+  tft_set_addr_window_raw(j.x, j.y, j.x + j.w - 1, j.y + j.h - 1);
+  tft_dc(1);
+  tft_cs(0);
+
+  dma_channel_config cfg = dma_channel_get_default_config(tftDmaChan);
+  channel_config_set_dreq(&cfg, spi_get_dreq(TFT_SPI, true));
+  channel_config_set_write_increment(&cfg, false);
+  volatile void *dr = &spi_get_hw(TFT_SPI)->dr;
+  if (j.src == nullptr) {
+    // 纯色: SPI 切换为 16 位帧, DMA 反复读取同一个颜色值
+    spi_set_format(TFT_SPI, 16, SPI_CPOL_0, SPI_CPHA_0, SPI_MSB_FIRST);
+    channel_config_set_transfer_data_size(&cfg, DMA_SIZE_16);
+    channel_config_set_read_increment(&cfg, false);
+    dma_channel_configure(tftDmaChan, &cfg, dr, &j.color, j.w * j.h, true);
+  } else {
+    // 像素块: 行连续时一次发完, 否则在中断里逐行续传
+    channel_config_set_transfer_data_size(&cfg, DMA_SIZE_8);
+    channel_config_set_read_increment(&cfg, true);
+    bool contiguous = j.stride == j.w;
+    jobRow = contiguous ? j.h : 1;
+    dma_channel_configure(tftDmaChan, &cfg, dr, j.src, (contiguous ? j.h : 1) * j.w * 2, true);
+  }
+  tftSpiBytes += j.w * j.h * 2;
+}
+
+void tft_dma_irq() {
+  uint32_t mask = 1u << tftDmaChan;
+  if (!(dma_hw->ints1 & mask)) {
+    return;
+  }
+  dma_hw->ints1 = mask;
+
+  TftJob &j = tftJobs[jobTail % TFT_JOB_MAX];
+  if (j.src != nullptr && jobRow < j.h) {
+    dma_channel_set_read_addr(tftDmaChan, j.src + jobRow * j.stride, false);
+    dma_channel_set_trans_count(tftDmaChan, j.w * 2, true);
+    jobRow++;
+    return;
+  }
+
+  // DMA 完成只代表数据进入 FIFO, 等移位结束后再释放片选
+  while (spi_is_busy(TFT_SPI)) {
+    tight_loop_contents();
+  }
+  tft_cs(1);
+  if (j.src == nullptr) {
+    spi_set_format(TFT_SPI, 8, SPI_CPOL_0, SPI_CPHA_0, SPI_MSB_FIRST);
+  }
+
+  jobTail = jobTail + 1;
+  if (jobTail != jobHead) {
+    tft_job_start(tftJobs[jobTail % TFT_JOB_MAX]);
+  } else {
+    tftDmaActive = false;
+    if (tftDmaDone) {
+      tftDmaDone();
+    }
+  }
+}
+
+void tft_dma_init() {
+  tftDmaChan = dma_claim_unused_channel(true);
+  dma_channel_set_irq1_enabled(tftDmaChan, true);
+  // 使用 DMA_IRQ_1, 与 ADC 采样的 DMA_IRQ_0 分开 (双核模式下两者在不同核上)
+  irq_add_shared_handler(DMA_IRQ_1, tft_dma_irq, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+  irq_set_enabled(DMA_IRQ_1, true);
+}
+
+void tft_job_push(const TftJob &job) {
+  while (jobHead - jobTail >= TFT_JOB_MAX) {
+    tight_loop_contents(); // 队列已满, 等待中断取走
+  }
+  uint32_t irq = save_and_disable_interrupts();
+  tftJobs[jobHead % TFT_JOB_MAX] = job;
+  jobHead = jobHead + 1;
+  if (!tftDmaActive) {
+    tftDmaActive = true;
+    tft_job_start(tftJobs[jobTail % TFT_JOB_MAX]);
+  }
+  restore_interrupts(irq);
+}
+
+void tft_fill_rect_async(int x, int y, int w, int h, uint16_t color) {
+  if (x >= TFT_WIDTH || y >= TFT_HEIGHT)
+    return;
+  if (x + w > TFT_WIDTH)
+    w = TFT_WIDTH - x;
+  if (y + h > TFT_HEIGHT)
+    h = TFT_HEIGHT - y;
+  if (w <= 0 || h <= 0)
+    return;
+  tft_job_push({(int16_t)x, (int16_t)y, (int16_t)w, (int16_t)h, nullptr, 0, color});
+}
+
+void tft_write_pixels_async(int x, int y, int w, int h, const uint16_t *px, int stride) {
+  if (w <= 0 || h <= 0)
+    return;
+  tft_job_push({(int16_t)x, (int16_t)y, (int16_t)w, (int16_t)h, px, (int16_t)stride, 0});
+}
+
+bool tft_dma_busy() {
+  return tftDmaActive;
+}
+
+void tft_dma_wait() {
+  if (!tftDmaActive) {
+    return;
+  }
+  unsigned long t0 = micros();
+  while (tftDmaActive) {
+    tight_loop_contents();
+  }
+  tftDmaWaitUs += micros() - t0;
+}
+
+void tft_set_dma_callback(void (*cb)()) {
+  tftDmaDone = cb;
+}
+#else
+// 未开启 DMA 时退化为阻塞发送
+void tft_fill_rect_async(int x, int y, int w, int h, uint16_t color) {
+  if (x >= TFT_WIDTH || y >= TFT_HEIGHT)
+    return;
+  if (x + w > TFT_WIDTH)
+    w = TFT_WIDTH - x;
+  if (y + h > TFT_HEIGHT)
+    h = TFT_HEIGHT - y;
+  if (w <= 0 || h <= 0)
+    return;
+  tft_fill_rect_blocking(x, y, w, h, color);
+}
+
+void tft_write_pixels_async(int x, int y, int w, int h, const uint16_t *px, int stride) {
+  tft_set_addr_window_raw(x, y, x + w - 1, y + h - 1);
+  tft_dc(1);
+  tft_cs(0);
+  for (int j = 0; j < h; j++) {
+    tft_spi_write((const uint8_t *)(px + j * stride), w * 2);
+  }
+  tft_cs(1);
+}
+
+bool tft_dma_busy() {
+  return false;
+}
+
+void tft_dma_wait() {
+}
+
+void tft_set_dma_callback(void (*cb)()) {
+}
+#endif
+
+// 初始化 TFT 屏幕
+void tft_init() {
+  tft_rst(1);
+  delay(10);
+
+  tft_rst(0);
+  delay(10);
+
+  tft_rst(1);
+  delay(100);
+
+  tft_write_cmd(0x01);
+  delay(150); // Software reset
+
+  tft_write_cmd(0x11);
+  delay(150); // Sleep out
+
+  tft_write_cmd(0x3A);
+  tft_write_data(0x05); // 16-bit color
+
+  tft_write_cmd(0x36);
+  // tft_write_data(0xA8); // 横屏
+  // tft_write_data(0x00); // 竖屏
+  tft_write_data(0x60); // 横屏翻转
+
+  // tft_write_cmd(0x21); // 颜色反转
+  tft_write_cmd(0x29); // Display ON
+
+#if TFT_DMA
+  tft_dma_init();
+#endif
+}
+
+#if TFT_FRAMEBUFFER
+/* ================= 帧缓冲 ================= */
+uint16_t tftFb[TFT_WIDTH * TFT_HEIGHT]; // RGB565, 高字节在前 (与 SPI 发送顺序一致)
+
+struct DirtyRect {
+  int16_t x1, y1, x2, y2; // 包含端点
+};
+DirtyRect dirtyRects[TFT_DIRTY_MAX];
+int dirtyCount = 0;
+
+inline int rect_area(int x1, int y1, int x2, int y2) {
+  return (x2 - x1 + 1) * (y2 - y1 + 1);
+}
+// 标记脏区域: 与已有区域相交或相邻时合并, 数量已满时并入面积增长最小的区域
+void tft_mark_dirty(int x1, int y1, int x2, int y2) {
+  int merge = -1;
+  for (int i = 0; i < dirtyCount; i++) {
+    DirtyRect &r = dirtyRects[i];
+    if (x1 <= r.x2 + 1 && x2 >= r.x1 - 1 && y1 <= r.y2 + 1 && y2 >= r.y1 - 1) {
+      merge = i;
+      break;
+    }
+  }
+  if (merge < 0 && dirtyCount < TFT_DIRTY_MAX) {
+    dirtyRects[dirtyCount++] = {(int16_t)x1, (int16_t)y1, (int16_t)x2, (int16_t)y2};
+    return;
+  }
+  if (merge < 0) {
+    int bestGrow = 0x7FFFFFFF;
+    for (int i = 0; i < dirtyCount; i++) {
+      DirtyRect &r = dirtyRects[i];
+      int grow = rect_area(min(x1, (int)r.x1), min(y1, (int)r.y1), max(x2, (int)r.x2), max(y2, (int)r.y2)) -
+                 rect_area(r.x1, r.y1, r.x2, r.y2);
+      if (grow < bestGrow) {
+        bestGrow = grow;
+        merge = i;
+      }
+    }
+  }
+  DirtyRect &r = dirtyRects[merge];
+  r.x1 = min(x1, (int)r.x1);
+  r.y1 = min(y1, (int)r.y1);
+  r.x2 = max(x2, (int)r.x2);
+  r.y2 = max(y2, (int)r.y2);
+}
+
+void tft_flush() {
+  for (int i = 0; i < dirtyCount; i++) {
+    DirtyRect &r = dirtyRects[i];
+    // 每个区域只设置一次地址窗口, 逐行发送帧缓冲
+    tft_write_pixels_async(r.x1, r.y1, r.x2 - r.x1 + 1, r.y2 - r.y1 + 1, &tftFb[r.y1 * TFT_WIDTH + r.x1], TFT_WIDTH);
+  }
+  dirtyCount = 0;
+}
+#else
+void tft_flush() {
+}
+#endif
+
+// 填充矩形区域
+void tft_fill_rect(int x, int y, int w, int h, uint16_t color) {
+  if (x >= TFT_WIDTH || y >= TFT_HEIGHT)
+    return;
+  if (x + w > TFT_WIDTH)
+    w = TFT_WIDTH - x;
+  if (y + h > TFT_HEIGHT)
+    h = TFT_HEIGHT - y;
+  if (w <= 0 || h <= 0)
+    return;
+
+#if TFT_FRAMEBUFFER
+  tft_dma_wait(); // 上一帧还在从帧缓冲发送时不能改写
+  uint16_t be = (color >> 8) | (color << 8);
+  for (int j = y; j < y + h; j++) {
+    uint16_t *row = &tftFb[j * TFT_WIDTH + x];
+    for (int i = 0; i < w; i++) {
+      row[i] = be;
+    }
+  }
+  tft_mark_dirty(x, y, x + w - 1, y + h - 1);
+#elif TFT_DMA
+  tft_fill_rect_async(x, y, w, h, color);
+#else
+  tft_fill_rect_blocking(x, y, w, h, color);
+#endif
+}
+// 填充全屏
+void tft_fill_screen(uint16_t color) {
+  tft_fill_rect(0, 0, TFT_WIDTH, TFT_HEIGHT, color);
+}
+
+// 简易 5x7 字体点阵 (部分常用字符: 0-9, A-Z, '.', ' ', 'd', 'B', 'H', 'z')
+const uint8_t font5x7[][5] = {
+    {0x3E, 0x51, 0x49, 0x45, 0x3E}, // 0
+    {0x00, 0x42, 0x7F, 0x40, 0x00}, // 1
+    {0x42, 0x61, 0x51, 0x49, 0x46}, // 2
+    {0x21, 0x41, 0x45, 0x4B, 0x31}, // 3
+    {0x18, 0x14, 0x12, 0x7F, 0x10}, // 4
+    {0x27, 0x45, 0x45, 0x45, 0x39}, // 5
+    {0x3C, 0x4A, 0x49, 0x49, 0x30}, // 6
+    {0x01, 0x71, 0x09, 0x05, 0x03}, // 7
+    {0x36, 0x49, 0x49, 0x49, 0x36}, // 8
+    {0x06, 0x49, 0x49, 0x29, 0x1E}, // 9
+    {0x00, 0x60, 0x60, 0x00, 0x00}, // .
+    {0x00, 0x00, 0x00, 0x00, 0x00}, // space
+    {0x7E, 0x11, 0x11, 0x11, 0x7E}, // A
+    {0x7F, 0x49, 0x49, 0x49, 0x36}, // B
+    {0x38, 0x44, 0x44, 0x44, 0x7F}, // d
+    {0x7F, 0x09, 0x09, 0x09, 0x01}, // F
+    {0x7F, 0x08, 0x08, 0x08, 0x7F}, // H
+    {0x44, 0x7D, 0x40, 0x00, 0x00}, // i
+    {0x44, 0x64, 0x54, 0x4C, 0x44}, // z
+};
+
+// 字符绘制函数
+void tft_draw_char(int x, int y, char c, uint16_t color) {
+  int idx = -1;
+  if (c >= '0' && c <= '9')
+    idx = c - '0';
+  else if (c == '.')
+    idx = 10;
+  else if (c == ' ')
+    idx = 11;
+  else if (c == 'A')
+    idx = 12;
+  else if (c == 'B')
+    idx = 13;
+  else if (c == 'd')
+    idx = 14;
+  else if (c == 'F')
+    idx = 15;
+  else if (c == 'H')
+    idx = 16;
+  else if (c == 'i')
+    idx = 17;
+  else if (c == 'z')
+    idx = 18;
+  if (idx == -1)
+    return;
+
+#if TFT_FRAMEBUFFER
+  // 直接写帧缓冲, 整个字符只标记一次脏区域
+  if (x < 0 || y < 0 || x + 5 > TFT_WIDTH || y + 7 > TFT_HEIGHT)
+    return;
+  tft_dma_wait();
+  uint16_t be = (color >> 8) | (color << 8);
+  for (int i = 0; i < 5; i++) {
+    uint8_t line = font5x7[idx][i];
+    for (int j = 0; j < 7; j++) {
+      if (line & (1 << j)) {
+        tftFb[(y + j) * TFT_WIDTH + x + i] = be;
+      }
+    }
+  }
+  tft_mark_dirty(x, y, x + 4, y + 6);
+#else
+  for (int i = 0; i < 5; i++) {
+    uint8_t line = font5x7[idx][i];
+    for (int j = 0; j < 7; j++) {
+      if (line & (1 << j)) {
+        tft_fill_rect(x + i, y + j, 1, 1, color);
+      }
+    }
+  }
+#endif
+}
+// 字符串绘制函数
+void tft_draw_string(int x, int y, const char *s, uint16_t color) {
+  while (*s) {
+    tft_draw_char(x, y, *s++, color);
+    x += 6;
+  }
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include "hardware/spi.h"
+#include <Arduino.h>
+
+/* ================= 硬件引脚定义 ================= */
+#define TFT_SPI spi0 // 使用 SPI0
+#define PIN_SCK 2    // SPI 时钟引脚
+#define PIN_MOSI 3   // SPI 主出从入引脚
+#define PIN_CS 1     // 片选引脚
+#define PIN_DC 5     // 数据/命令引脚
+#define PIN_RST 4    // 复位引脚
+
+#define TFT_BAUD 40000000 // SPI 时钟 20/40 MHz
+#define TFT_WIDTH 160     // ST7735 屏幕宽度
+#define TFT_HEIGHT 80     // ST7735 屏幕高度
+
+#ifndef TFT_FRAMEBUFFER
+#define TFT_FRAMEBUFFER 1 // 1: 绘制先写入 RAM 帧缓冲 (25.6KB), tft_flush() 只发送脏矩形
+#endif
+#define TFT_DIRTY_MAX 8   // 脏矩形最大数量, 超出后合并
+#ifndef TFT_DMA
+#define TFT_DMA 1         // 1: 填充与帧缓冲刷新通过 DMA 异步发送
+#endif
+#define TFT_JOB_MAX 16    // DMA 传输队列长度
+
+extern uint32_t tftSpiBytes;   // 累计 SPI 发送字节数 (统计用)
+extern uint32_t tftDmaWaitUs;  // 累计等待 DMA 完成的时间 (统计用)
+
+void tft_write_cmd(uint8_t cmd);
+void tft_write_data(uint8_t data);
+void tft_set_addr_window(int x1, int y1, int x2, int y2);
+void tft_init();
+void tft_fill_rect(int x, int y, int w, int h, uint16_t color);
+void tft_fill_screen(uint16_t color);
+void tft_draw_char(int x, int y, char c, uint16_t color);
+void tft_draw_string(int x, int y, const char *s, uint16_t color);
+// 把帧缓冲中的脏矩形发送到屏幕 (未开启帧缓冲时为空操作), 开启 DMA 时立即返回
+void tft_flush();
+
+/* ================= DMA 异步传输 ================= */
+// 异步纯色填充 (DMA 固定读取地址, SPI 16 位帧)
+void tft_fill_rect_async(int x, int y, int w, int h, uint16_t color);
+// 异步发送像素块, px 为高字节在前的 RGB565, stride 为每行像素数
+void tft_write_pixels_async(int x, int y, int w, int h, const uint16_t *px, int stride);
+// 是否还有未完成的传输
+bool tft_dma_busy();
+// 等待所有传输完成 (栅栏)
+void tft_dma_wait();
+// 设置队列发送完毕时的回调 (在 DMA 中断中调用)
+void tft_set_dma_callback(void (*cb)());